@@ -29,12 +29,15 @@
 #include <tsppd/data/tsppd_problem_generator.h>
 #include <tsppd/io/tsp_problem_reader.h>
 #include <tsppd/io/tsp_problem_writer.h>
+#include <tsppd/solver/alns/alns_tsppd_solver.h>
+#include <tsppd/solver/dp/dp_tsppd_solver.h>
 #include <tsppd/solver/enumerative/enumerative_tsp_solver.h>
 #include <tsppd/solver/enumerative/enumerative_tsppd_solver.h>
 #include <tsppd/solver/ap/ap_atsp_solver.h>
 #include <tsppd/solver/ap/ap_atsppd_solver.h>
 #include <tsppd/solver/focacci/focacci_tsp_solver.h>
 #include <tsppd/solver/focacci/focacci_tsppd_solver.h>
+#include <tsppd/solver/grasp/grasp_tsppd_solver.h>
 #include <tsppd/solver/oneil/oneil_atsppd_plus_solver.h>
 #include <tsppd/solver/oneil/oneil_atsppd_solver.h>
 #include <tsppd/solver/ruland/ruland_tsp_solver.h>
@@ -166,7 +169,7 @@ int main(int argc, char** argv) {
     // Name of the solver.
     auto solver_abbrev = varmap["solver"].as<string>();
 
-    // Number of solver threads (MIP & CP only).
+    // Number of solver threads (MIP, CP, GRASP & DP only).
     unsigned int threads = 1;
     if (varmap.count("threads") == 1) {
         threads = varmap["threads"].as<unsigned int>();
@@ -212,10 +215,17 @@ int main(int argc, char** argv) {
         else if (solver_abbrev == "atsppd-oneil+")
             solver = make_shared<ONeilATSPPDPlusSolver>(problem, solver_options, writer);
 
+        else if (solver_abbrev == "tsppd-alns")
+            solver = make_shared<ALNSTSPPDSolver>(problem, solver_options, writer);
+        else if (solver_abbrev == "tsppd-grasp")
+            solver = make_shared<GRASPTSPPDSolver>(problem, solver_options, writer);
+
         else if (solver_abbrev == "tsp-enum")
             solver = make_shared<EnumerativeTSPSolver>(problem, solver_options, writer);
         else if (solver_abbrev == "tsppd-enum")
             solver = make_shared<EnumerativeTSPPDSolver>(problem, solver_options, writer);
+        else if (solver_abbrev == "tsppd-dp")
+            solver = make_shared<DPTSPPDSolver>(problem, solver_options, writer);
 
         else if (solver_abbrev == "tsp-focacci")
             solver = make_shared<FocacciTSPSolver>(problem, solver_options, writer);
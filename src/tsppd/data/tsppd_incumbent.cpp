@@ -0,0 +1,60 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <limits>
+
+#include <tsppd/data/tsppd_incumbent.h>
+
+using namespace TSPPD::Data;
+using namespace std;
+
+TSPPDIncumbent::TSPPDIncumbent(const TSPPDProblem& problem) :
+    problem(problem),
+    best_cost(numeric_limits<int>::max()),
+    best_order(problem.nodes),
+    mutex() { }
+
+bool TSPPDIncumbent::improve(const vector<string>& order, const int cost) {
+    return improve(order, cost, [] { });
+}
+
+bool TSPPDIncumbent::improve(
+    const vector<string>& order,
+    const int cost,
+    const function<void()>& improved) {
+
+    lock_guard<std::mutex> lock(mutex);
+    if (cost >= best_cost)
+        return false;
+
+    best_order = order;
+    best_cost = cost;
+    improved();
+    return true;
+}
+
+bool TSPPDIncumbent::has_solution() const {
+    return best_cost < numeric_limits<int>::max();
+}
+
+int TSPPDIncumbent::cost() const {
+    return best_cost;
+}
+
+vector<string> TSPPDIncumbent::order() const {
+    lock_guard<std::mutex> lock(mutex);
+    return best_order;
+}
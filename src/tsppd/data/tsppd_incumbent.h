@@ -0,0 +1,60 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_DATA_TSPPD_INCUMBENT_H
+#define TSPPD_DATA_TSPPD_INCUMBENT_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <tsppd/data/tsppd_problem.h>
+
+namespace TSPPD {
+    namespace Data {
+        // Best known tour, shared between concurrent searches. The cost can be
+        // read without locking so it is cheap to consult from propagators.
+        class TSPPDIncumbent {
+        public:
+            TSPPDIncumbent(const TSPPD::Data::TSPPDProblem& problem);
+
+            bool improve(const std::vector<std::string>& order, const int cost);
+
+            // As above, but calls improved while still holding the lock so that
+            // callers reporting each new tour do so in order of improvement.
+            bool improve(
+                const std::vector<std::string>& order,
+                const int cost,
+                const std::function<void()>& improved
+            );
+
+            bool has_solution() const;
+            int cost() const;
+            std::vector<std::string> order() const;
+
+        protected:
+            const TSPPD::Data::TSPPDProblem& problem;
+
+            std::atomic<int> best_cost;
+            std::vector<std::string> best_order;
+            mutable std::mutex mutex;
+        };
+    }
+}
+
+#endif
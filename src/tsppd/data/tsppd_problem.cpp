@@ -57,12 +57,14 @@ TSPPDProblem::TSPPDProblem(
     coordinates(coordinates),
     node_to_index(build_node_to_index()),
     arc_vectors(nodes.size(), vector<TSPPDArc>()),
+    cost_matrix_vec(nodes.size() * nodes.size(), 0),
     has_predecessor_vec(nodes.size(), false),
     has_successor_vec(nodes.size(), false),
     predecessor_vec(nodes.size(), 0),
     successor_vec(nodes.size(), 0) {
 
     initialize_arc_vectors();
+    initialize_cost_matrix();
     initialize_precedence(pickup_delivery_pairs);
 }
 
@@ -85,6 +87,7 @@ void TSPPDProblem::make_asymmetric(unsigned int seed) {
             edge_weights[i].push_back((int) round(edge_weights[j][i] * v));
         }
     asymmetric = true;
+    initialize_cost_matrix();
     name += "-a" + to_string(seed);
 }
 
@@ -187,6 +190,14 @@ void TSPPDProblem::initialize_arc_vectors() {
         sort(arc_vectors[i].begin(), arc_vectors[i].end());
 }
 
+void TSPPDProblem::initialize_cost_matrix() {
+    auto size = nodes.size();
+    for (size_t i = 0; i < size; ++i)
+        for (size_t j = 0; j < size; ++j)
+            if (i != j)
+                cost_matrix_vec[i * size + j] = cost(i, j);
+}
+
 void TSPPDProblem::initialize_precedence(const vector<pair<string, string>>& pickup_delivery_pairs) {
     for (auto p : pickup_delivery_pairs) {
         auto pickup_index = index(p.first);
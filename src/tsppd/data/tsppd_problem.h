@@ -65,6 +65,10 @@ namespace TSPPD {
             int cost(const std::string node1, const std::string node2) const;
             int cost(const unsigned int node_index_1, const unsigned int node_index_2) const;
 
+            // Row-major n x n matrix of arc costs, for code that is too hot to
+            // call cost() from.
+            const std::vector<int>& cost_matrix() const { return cost_matrix_vec; }
+
             std::vector<std::string> pickups() const;
             std::vector<std::string> deliveries() const;
 
@@ -108,6 +112,7 @@ namespace TSPPD {
             std::map<std::string, unsigned int> build_node_to_index() const;
 
             void initialize_arc_vectors();
+            void initialize_cost_matrix();
             void initialize_precedence(const std::vector<std::pair<std::string, std::string>>& pickup_delivery_pairs);
 
             std::vector<std::pair<double, double>> coordinates;
@@ -119,6 +124,7 @@ namespace TSPPD {
 
             std::map<std::string, unsigned int> node_to_index;
             std::vector<std::vector<TSPPDArc>> arc_vectors;
+            std::vector<int> cost_matrix_vec;
 
             std::vector<bool> has_predecessor_vec;
             std::vector<bool> has_successor_vec;
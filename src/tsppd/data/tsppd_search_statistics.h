@@ -35,6 +35,10 @@ namespace TSPPD {
             bool has_tour() const { return tour.size() > 0; }
             bool is_optimal() const { return optimal; }
 
+            // Relative optimality gap: (primal - dual) / primal
+            bool has_gap() const { return has_primal() && has_dual() && primal > 0; }
+            double gap() const { return (primal - dual) / (double) primal; }
+
             // Search information
             bool has_nodes() const { return nodes >= 0; }
             bool has_fails() const { return fails >= 0; }
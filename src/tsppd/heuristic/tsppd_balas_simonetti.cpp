@@ -0,0 +1,156 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#include <algorithm>
+#include <limits>
+
+#include <tsppd/heuristic/tsppd_balas_simonetti.h>
+
+using namespace TSPPD::Data;
+using namespace TSPPD::Heuristic;
+using namespace std;
+
+TSPPDBalasSimonetti::TSPPDBalasSimonetti(const TSPPDProblem& problem, const unsigned int window) :
+    problem(problem),
+    size(problem.nodes.size()),
+    window(max(window, 1u)),
+    costs(problem.cost_matrix()),
+    pickups(size, -1),
+    positions(size, -1),
+    values(),
+    parents() {
+
+    for (auto pickup : problem.pickup_indices())
+        pickups[problem.successor_index(pickup)] = pickup;
+}
+
+int TSPPDBalasSimonetti::improve(vector<unsigned int>& tour) {
+    while (search(tour)) { }
+    return cost(tour);
+}
+
+int TSPPDBalasSimonetti::cost(const vector<unsigned int>& tour) const {
+    int total = arc_cost(tour.back(), tour.front());
+    for (unsigned int i = 0; i + 1 < tour.size(); ++i)
+        total += arc_cost(tour[i], tour[i + 1]);
+    return total;
+}
+
+// Positions run over the m nodes between +0 and -0, so the node at position p
+// is tour[p + 1] and +0 is at position -1. A state (j, placed, offset) has
+// every position before j placed, position j not, position j + b + 1 placed
+// for each bit b in placed, and the last node placed at j + offset, with
+// offset in [-k, k - 1].
+bool TSPPDBalasSimonetti::search(vector<unsigned int>& tour) {
+    if (tour.size() < 4)
+        return false;
+
+    const int m = tour.size() - 2;
+    const int k = min((int) window, m);
+    const int masks = 1 << (k - 1);
+    const int offsets = 2 * k;
+
+    auto state = [&](int j, int placed, int offset) { return (j * masks + placed) * offsets + offset + k; };
+
+    for (int p = 0; p < m; ++p)
+        positions[tour[p + 1]] = p;
+
+    const auto infinity = numeric_limits<int>::max();
+    values.assign((m + 1) * masks * offsets, infinity);
+    parents.assign(values.size(), -1);
+
+    auto start = state(0, 0, -1);
+    values[start] = 0;
+
+    for (int j = 0; j < m; ++j) {
+        for (int placed = 0; placed < masks; ++placed) {
+            for (int offset = -k; offset < k; ++offset) {
+                auto from_state = state(j, placed, offset);
+                auto value = values[from_state];
+                if (value == infinity)
+                    continue;
+
+                auto from = tour[j + offset + 1];
+                for (int t = 0; t < k && j + t < m; ++t) {
+                    if (t > 0 && (placed >> (t - 1)) & 1)
+                        continue;
+
+                    // A delivery needs its pickup placed already.
+                    auto to = tour[j + t + 1];
+                    if (pickups[to] >= 0) {
+                        auto q = positions[pickups[to]];
+                        if (q >= j && !(q > j && (placed >> (q - j - 1)) & 1))
+                            continue;
+                    }
+
+                    int to_state;
+                    if (t == 0) {
+                        // Skip past every position that is now placed.
+                        auto all = (placed << 1) | 1;
+                        int shift = 0;
+                        while ((all >> shift) & 1)
+                            ++shift;
+                        to_state = state(j + shift, all >> (shift + 1), -shift);
+                    } else {
+                        to_state = state(j, placed | (1 << (t - 1)), t);
+                    }
+
+                    auto to_value = value + arc_cost(from, to);
+                    if (to_value < values[to_state]) {
+                        values[to_state] = to_value;
+                        parents[to_state] = from_state;
+                    }
+                }
+            }
+        }
+    }
+
+    // Close each path with the arc into -0 and compare to the current tour.
+    auto current = 0;
+    for (int p = -1; p < m; ++p)
+        current += arc_cost(tour[p + 1], tour[p + 2]);
+
+    auto best = current;
+    auto best_state = -1;
+    for (int offset = -k; offset < 0; ++offset) {
+        auto s = state(m, 0, offset);
+        if (values[s] == infinity)
+            continue;
+
+        auto value = values[s] + arc_cost(tour[m + offset + 1], tour[m + 1]);
+        if (value < best) {
+            best = value;
+            best_state = s;
+        }
+    }
+
+    if (best_state < 0)
+        return false;
+
+    // Walk back through the states, reading off the last node placed in each.
+    vector<unsigned int> reordered(tour.size());
+    reordered.front() = tour.front();
+    reordered.back() = tour.back();
+
+    auto p = m;
+    for (auto s = best_state; s != start; s = parents[s]) {
+        auto j = s / (masks * offsets);
+        auto offset = s % offsets - k;
+        reordered[p--] = tour[j + offset + 1];
+    }
+
+    tour = reordered;
+    return true;
+}
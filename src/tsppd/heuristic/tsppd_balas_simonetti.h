@@ -0,0 +1,68 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef TSPPD_HEURISTIC_TSPPD_BALAS_SIMONETTI_H
+#define TSPPD_HEURISTIC_TSPPD_BALAS_SIMONETTI_H
+
+#include <vector>
+
+#include <tsppd/data/tsppd_problem.h>
+
+// Dynamic programming neighborhood based on:
+//
+// Egon Balas and Neil Simonetti.
+// "Linear time dynamic-programming algorithms for new classes of restricted
+// TSPs: A computational study."
+// INFORMS Journal on Computing 13, no. 1 (2001): 56-75.
+//
+// Given a tour, finds the cheapest reordering in which a node at position i
+// still comes before every node at position i + window or later. Deliveries
+// may only be placed once their pickups are. States are the first node that
+// is not placed yet, which of the next window - 1 nodes are, and the last node
+// placed, so each pass takes O(n * window^2 * 2^window) time.
+namespace TSPPD {
+    namespace Heuristic {
+        class TSPPDBalasSimonetti {
+        public:
+            TSPPDBalasSimonetti(const TSPPD::Data::TSPPDProblem& problem, const unsigned int window = 6);
+
+            // Moves to the best tour in the neighborhood until it stops improving.
+            // Returns the new cost.
+            int improve(std::vector<unsigned int>& tour);
+
+            int cost(const std::vector<unsigned int>& tour) const;
+
+        protected:
+            // One pass over the neighborhood. Returns true if tour was improved.
+            bool search(std::vector<unsigned int>& tour);
+
+            int arc_cost(const unsigned int from, const unsigned int to) const { return costs[from * size + to]; }
+
+            const TSPPD::Data::TSPPDProblem& problem;
+            const unsigned int size;
+            const unsigned int window;
+
+            const std::vector<int>& costs;  // size x size
+            std::vector<int> pickups;       // pickup of each delivery, or -1
+
+            // Reused between passes.
+            std::vector<int> positions;     // position of each node between +0 and -0
+            std::vector<int> values;        // cheapest path to each state
+            std::vector<int> parents;       // state each one is reached from
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,334 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#include <algorithm>
+#include <limits>
+
+#include <tsppd/heuristic/tsppd_local_search.h>
+
+using namespace TSPPD::Data;
+using namespace TSPPD::Heuristic;
+using namespace std;
+
+TSPPDLocalSearch::TSPPDLocalSearch(const TSPPDProblem& problem, const unsigned int neighbors) :
+    problem(problem),
+    size(problem.nodes.size()),
+    start_index(0),
+    end_index(problem.successor_index(0)),
+    costs(problem.cost_matrix()),
+    partners(size, -1),
+    out_neighbors(size),
+    in_neighbors(size),
+    route(),
+    positions(size, 0),
+    forward_costs(size, 0),
+    backward_costs(size, 0),
+    reverse_limits(size, size) {
+
+    for (auto pickup : problem.pickup_indices()) {
+        auto delivery = problem.successor_index(pickup);
+        partners[pickup] = delivery;
+        partners[delivery] = pickup;
+    }
+
+    auto k = min(neighbors, size - 1);
+    for (unsigned int i = 0; i < size; ++i) {
+        vector<unsigned int> others;
+        for (unsigned int j = 0; j < size; ++j)
+            if (j != i)
+                others.push_back(j);
+
+        partial_sort(others.begin(), others.begin() + k, others.end(), [&](unsigned int a, unsigned int b) {
+            return arc_cost(i, a) < arc_cost(i, b);
+        });
+        out_neighbors[i] = vector<unsigned int>(others.begin(), others.begin() + k);
+
+        partial_sort(others.begin(), others.begin() + k, others.end(), [&](unsigned int a, unsigned int b) {
+            return arc_cost(a, i) < arc_cost(b, i);
+        });
+        in_neighbors[i] = vector<unsigned int>(others.begin(), others.begin() + k);
+    }
+}
+
+vector<unsigned int> TSPPDLocalSearch::nearest_neighbor() const {
+    vector<unsigned int> tour = {start_index};
+    vector<bool> visited(size, false);
+    visited[start_index] = true;
+
+    while (tour.size() + 1 < size) {
+        auto from = tour.back();
+        auto best_to = end_index;
+        auto best_cost = numeric_limits<int>::max();
+
+        for (unsigned int to = 0; to < size; ++to) {
+            if (visited[to] || to == end_index)
+                continue;
+            if (problem.has_predecessor(to) && !visited[problem.predecessor_index(to)])
+                continue;
+            if (arc_cost(from, to) < best_cost) {
+                best_to = to;
+                best_cost = arc_cost(from, to);
+            }
+        }
+
+        tour.push_back(best_to);
+        visited[best_to] = true;
+    }
+
+    tour.push_back(end_index);
+    return tour;
+}
+
+int TSPPDLocalSearch::improve(vector<unsigned int>& tour) {
+    route = tour;
+    update();
+
+    bool improved = true;
+    while (improved) {
+        improved = two_opt();
+        improved = or_opt() || improved;
+        improved = pair_relocate() || improved;
+    }
+
+    tour = route;
+    return cost(tour);
+}
+
+// Includes the leg from -0 back to +0, as TSPPDSolution does.
+int TSPPDLocalSearch::cost(const vector<unsigned int>& tour) const {
+    int c = arc_cost(tour.back(), tour.front());
+    for (size_t i = 1; i < tour.size(); ++i)
+        c += arc_cost(tour[i - 1], tour[i]);
+    return c;
+}
+
+bool TSPPDLocalSearch::feasible(const vector<unsigned int>& tour) const {
+    if (tour.size() != size || tour.front() != start_index || tour.back() != end_index)
+        return false;
+
+    vector<bool> visited(size, false);
+    for (auto node : tour) {
+        if (node >= size || visited[node])
+            return false;
+        if (problem.has_predecessor(node) && !visited[problem.predecessor_index(node)])
+            return false;
+        visited[node] = true;
+    }
+
+    return true;
+}
+
+// Reverses route[i..j] where the arc into it goes to one of the closest
+// neighbors of route[i - 1].
+bool TSPPDLocalSearch::two_opt() {
+    bool improved = false;
+
+    for (unsigned int i = 1; i + 2 < size; ++i) {
+        for (auto v : out_neighbors[route[i - 1]]) {
+            auto j = positions[v];
+            if (j <= i || j + 1 >= size || j >= reverse_limits[i])
+                continue;
+
+            auto a = route[i - 1];
+            auto b = route[i];
+            auto c = route[j + 1];
+
+            int delta = arc_cost(a, v) + arc_cost(b, c) - arc_cost(a, b) - arc_cost(v, c) +
+                (backward_costs[j] - backward_costs[i]) - (forward_costs[j] - forward_costs[i]);
+
+            if (delta < 0) {
+                reverse(route.begin() + i, route.begin() + j + 1);
+                update();
+                improved = true;
+                break;
+            }
+        }
+    }
+
+    return improved;
+}
+
+// Moves route[i..i + length - 1] after one of the closest neighbors into its
+// first node, keeping its orientation.
+bool TSPPDLocalSearch::or_opt() {
+    bool improved = false;
+
+    for (unsigned int length = 1; length <= 3; ++length) {
+        for (unsigned int i = 1; i + length < size; ++i) {
+            auto last_position = i + length - 1;
+            auto first = route[i];
+            auto last = route[last_position];
+
+            // Deliveries of pickups in the segment bound how far forward it may
+            // go, and pickups of its deliveries bound how far back.
+            unsigned int forward_limit = size - 1;
+            unsigned int backward_limit = 0;
+            for (auto k = i; k <= last_position; ++k) {
+                auto partner = partners[route[k]];
+                if (partner < 0)
+                    continue;
+                auto partner_position = positions[partner];
+                if (partner_position > last_position)
+                    forward_limit = min(forward_limit, partner_position);
+                else if (partner_position < i)
+                    backward_limit = max(backward_limit, partner_position);
+            }
+
+            auto a = route[i - 1];
+            auto b = route[last_position + 1];
+            int removal = arc_cost(a, b) - arc_cost(a, first) - arc_cost(last, b);
+
+            for (auto u : in_neighbors[first]) {
+                auto j = positions[u];
+                if (j + 1 >= size || (j + 1 >= i && j <= last_position))
+                    continue;
+                if (j > last_position && j >= forward_limit)
+                    continue;
+                if (j < i && j < backward_limit)
+                    continue;
+
+                auto w = route[j + 1];
+                int delta = removal + arc_cost(u, first) + arc_cost(last, w) - arc_cost(u, w);
+
+                if (delta < 0) {
+                    if (j > last_position)
+                        rotate(route.begin() + i, route.begin() + last_position + 1, route.begin() + j + 1);
+                    else
+                        rotate(route.begin() + j + 1, route.begin() + i, route.begin() + last_position + 1);
+                    update();
+                    improved = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    return improved;
+}
+
+// Takes each pickup and delivery out of the route and puts them back after
+// closest neighbors, either together or with the pickup somewhere earlier.
+bool TSPPDLocalSearch::pair_relocate() {
+    bool improved = false;
+
+    for (auto pickup : problem.pickup_indices()) {
+        auto delivery = problem.successor_index(pickup);
+        auto pickup_position = positions[pickup];
+        auto delivery_position = positions[delivery];
+
+        int removal;
+        if (delivery_position == pickup_position + 1) {
+            auto a = route[pickup_position - 1];
+            auto b = route[delivery_position + 1];
+            removal = arc_cost(a, b) - arc_cost(a, pickup) - arc_cost(pickup, delivery) - arc_cost(delivery, b);
+        } else {
+            auto a = route[pickup_position - 1];
+            auto b = route[pickup_position + 1];
+            auto x = route[delivery_position - 1];
+            auto y = route[delivery_position + 1];
+            removal = arc_cost(a, b) - arc_cost(a, pickup) - arc_cost(pickup, b) +
+                arc_cost(x, y) - arc_cost(x, delivery) - arc_cost(delivery, y);
+        }
+
+        int best_delta = 0;
+        int best_u = -1;
+        int best_v = -1;
+
+        for (auto u : in_neighbors[pickup]) {
+            if (u == delivery || u == end_index)
+                continue;
+
+            auto u_next = reduced_successor(u, pickup, delivery);
+            int pickup_insertion = arc_cost(u, pickup) + arc_cost(pickup, u_next) - arc_cost(u, u_next);
+
+            int together = removal + arc_cost(u, pickup) + arc_cost(pickup, delivery) +
+                arc_cost(delivery, u_next) - arc_cost(u, u_next);
+            if (together < best_delta) {
+                best_delta = together;
+                best_u = u;
+                best_v = u;
+            }
+
+            for (auto v : in_neighbors[delivery]) {
+                if (v == pickup || v == end_index || positions[v] <= positions[u])
+                    continue;
+
+                auto v_next = reduced_successor(v, pickup, delivery);
+                int delta = removal + pickup_insertion +
+                    arc_cost(v, delivery) + arc_cost(delivery, v_next) - arc_cost(v, v_next);
+
+                if (delta < best_delta) {
+                    best_delta = delta;
+                    best_u = u;
+                    best_v = v;
+                }
+            }
+        }
+
+        if (best_u < 0)
+            continue;
+
+        route.erase(route.begin() + delivery_position);
+        route.erase(route.begin() + pickup_position);
+
+        auto u_it = find(route.begin(), route.end(), (unsigned int) best_u);
+        if (best_u == best_v) {
+            route.insert(u_it + 1, {pickup, delivery});
+        } else {
+            auto v_it = find(u_it, route.end(), (unsigned int) best_v);
+            route.insert(v_it + 1, delivery);
+            u_it = find(route.begin(), route.end(), (unsigned int) best_u);
+            route.insert(u_it + 1, pickup);
+        }
+
+        update();
+        improved = true;
+    }
+
+    return improved;
+}
+
+void TSPPDLocalSearch::update() {
+    for (unsigned int k = 0; k < size; ++k)
+        positions[route[k]] = k;
+
+    forward_costs[0] = 0;
+    backward_costs[0] = 0;
+    for (unsigned int k = 1; k < size; ++k) {
+        forward_costs[k] = forward_costs[k - 1] + arc_cost(route[k - 1], route[k]);
+        backward_costs[k] = backward_costs[k - 1] + arc_cost(route[k], route[k - 1]);
+    }
+
+    // A segment starting at i cannot be reversed past the delivery of any
+    // pickup it contains.
+    reverse_limits[size - 1] = size;
+    for (unsigned int k = size - 1; k-- > 0;) {
+        reverse_limits[k] = reverse_limits[k + 1];
+        auto partner = partners[route[k]];
+        if (partner >= 0 && positions[partner] > k)
+            reverse_limits[k] = min(reverse_limits[k], positions[partner]);
+    }
+}
+
+unsigned int TSPPDLocalSearch::reduced_successor(
+    const unsigned int node,
+    const unsigned int pickup,
+    const unsigned int delivery) const {
+
+    auto k = positions[node] + 1;
+    while (route[k] == pickup || route[k] == delivery)
+        ++k;
+    return route[k];
+}
@@ -0,0 +1,85 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef TSPPD_HEURISTIC_TSPPD_LOCAL_SEARCH_H
+#define TSPPD_HEURISTIC_TSPPD_LOCAL_SEARCH_H
+
+#include <vector>
+
+#include <tsppd/data/tsppd_problem.h>
+
+// Local search over tours of node indices that start at +0 and end at -0.
+// Every move keeps pickups ahead of their deliveries and is checked for
+// precedence and priced in constant time:
+//
+//     2-opt:         reverses a segment, priced with prefix sums of the tour in
+//                    both directions so asymmetric costs are handled
+//     Or-opt:        moves a segment of up to 3 nodes elsewhere in the tour
+//     pair relocate: moves a pickup and its delivery to new positions
+//
+// Candidate moves are limited to each node's closest neighbors.
+namespace TSPPD {
+    namespace Heuristic {
+        class TSPPDLocalSearch {
+        public:
+            TSPPDLocalSearch(const TSPPD::Data::TSPPDProblem& problem, const unsigned int neighbors = 10);
+
+            // Greedy tour that always moves to the closest node it may visit next.
+            std::vector<unsigned int> nearest_neighbor() const;
+
+            // Applies improving moves until none are left. Returns the new cost.
+            int improve(std::vector<unsigned int>& tour);
+
+            int cost(const std::vector<unsigned int>& tour) const;
+            bool feasible(const std::vector<unsigned int>& tour) const;
+
+            int arc_cost(const unsigned int from, const unsigned int to) const { return costs[from * size + to]; }
+
+        protected:
+            bool two_opt();
+            bool or_opt();
+            bool pair_relocate();
+
+            // Rebuilds positions, prefix sums and reversal limits for the route.
+            void update();
+
+            // Successor of node once pickup and delivery are taken out of the route.
+            unsigned int reduced_successor(
+                const unsigned int node,
+                const unsigned int pickup,
+                const unsigned int delivery
+            ) const;
+
+            const TSPPD::Data::TSPPDProblem& problem;
+            const unsigned int size;
+            const unsigned int start_index;
+            const unsigned int end_index;
+
+            const std::vector<int>& costs;                          // size x size
+            std::vector<int> partners;                              // other node in each pair, or -1
+            std::vector<std::vector<unsigned int>> out_neighbors;   // closest nodes to go to
+            std::vector<std::vector<unsigned int>> in_neighbors;    // closest nodes to come from
+
+            // Route being improved.
+            std::vector<unsigned int> route;
+            std::vector<unsigned int> positions;
+            std::vector<int> forward_costs;     // cost of the route up to each position
+            std::vector<int> backward_costs;    // the same with every arc reversed
+            std::vector<unsigned int> reverse_limits;   // segments from i may reverse up to here
+        };
+    }
+}
+
+#endif
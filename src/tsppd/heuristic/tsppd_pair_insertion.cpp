@@ -0,0 +1,216 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#include <algorithm>
+#include <limits>
+
+#include <tsppd/heuristic/tsppd_pair_insertion.h>
+
+using namespace TSPPD::Data;
+using namespace TSPPD::Heuristic;
+using namespace std;
+
+TSPPDPairInsertion::TSPPDPairInsertion(const TSPPDProblem& problem) :
+    problem(problem),
+    size(problem.nodes.size()),
+    costs(problem.cost_matrix()),
+    route(),
+    positions(size, -1),
+    best_count(1),
+    cache(size),
+    pickup_bounds(size, 0),
+    delivery_bounds(size, 0) {
+}
+
+void TSPPDPairInsertion::insert(vector<unsigned int>& tour, const vector<unsigned int>& pickups, const unsigned int k) {
+    route = tour;
+    best_count = max(k, 1u);
+
+    fill_n(positions.begin(), size, -1);
+    for (unsigned int i = 0; i < route.size(); ++i)
+        positions[route[i]] = i;
+
+    auto pending = pickups;
+    for (auto pickup : pending)
+        fill(pickup);
+
+    while (!pending.empty()) {
+        size_t best_index = 0;
+        int best_regret = -1;
+
+        for (size_t h = 0; h < pending.size(); ++h) {
+            auto& moves = cache[pending[h]];
+            auto top = min((size_t) best_count, moves.size());
+
+            int regret = 0;
+            for (size_t m = 1; m < top; ++m)
+                regret += moves[m].cost - moves[0].cost;
+
+            auto& best_moves = cache[pending[best_index]];
+            if (regret > best_regret || (regret == best_regret && moves[0].cost < best_moves[0].cost)) {
+                best_index = h;
+                best_regret = regret;
+            }
+        }
+
+        auto pickup = pending[best_index];
+        auto move = cache[pickup][0];
+        pending.erase(pending.begin() + best_index);
+
+        auto added = apply(pickup, move);
+        for (auto other : pending)
+            update(other, added);
+    }
+
+    tour = route;
+}
+
+vector<unsigned int> TSPPDPairInsertion::construct(const unsigned int k) {
+    vector<unsigned int> tour = {0, problem.successor_index(0)};
+    insert(tour, problem.pickup_indices(), k);
+    return tour;
+}
+
+// Cheapest way to insert a pair for each position of its pickup. The best
+// delivery position after each point in the route is kept as a suffix
+// minimum, so this is linear in the length of the route.
+void TSPPDPairInsertion::fill(const unsigned int pickup) {
+    auto delivery = problem.successor_index(pickup);
+    auto m = route.size();
+
+    vector<int> suffix_costs(m - 1);
+    vector<unsigned int> suffix_nodes(m - 1);
+    pickup_bounds[pickup] = numeric_limits<int>::max();
+    delivery_bounds[pickup] = numeric_limits<int>::max();
+    for (auto j = m - 1; j-- > 0;) {
+        pickup_bounds[pickup] = min(pickup_bounds[pickup], detour(route[j], pickup));
+        delivery_bounds[pickup] = min(delivery_bounds[pickup], detour(route[j], delivery));
+
+        auto c = detour(route[j], delivery);
+        if (j + 2 == m || c < suffix_costs[j + 1]) {
+            suffix_costs[j] = c;
+            suffix_nodes[j] = route[j];
+        } else {
+            suffix_costs[j] = suffix_costs[j + 1];
+            suffix_nodes[j] = suffix_nodes[j + 1];
+        }
+    }
+
+    vector<TSPPDPairInsertionMove> moves;
+    moves.reserve(m - 1);
+    for (unsigned int i = 0; i + 1 < m; ++i) {
+        auto a = route[i];
+        auto b = route[i + 1];
+
+        TSPPDPairInsertionMove move = {
+            arc_cost(a, pickup) + arc_cost(pickup, delivery) + arc_cost(delivery, b) - arc_cost(a, b), a, a
+        };
+
+        if (i + 2 < m) {
+            auto c = detour(a, pickup) + suffix_costs[i + 1];
+            if (c < move.cost)
+                move = {c, a, suffix_nodes[i + 1]};
+        }
+
+        moves.push_back(move);
+    }
+
+    keep_best(pickup, moves);
+}
+
+// Added holds every node with a new arc out of it. Cached moves that use none
+// of them keep their costs, and the detours of pickup and delivery into arcs
+// that were not replaced do not change, so the bounds only need the new arcs.
+// A move into a new arc costs at least its detour there plus the bound on the
+// other node, so if none of those can reach the kth cached cost the cache is
+// still exact. Ties refill too, so the cache always matches a full fill.
+void TSPPDPairInsertion::update(const unsigned int pickup, const vector<unsigned int>& added) {
+    auto& cached = cache[pickup];
+    for (auto& move : cached) {
+        for (auto node : added) {
+            if (move.pickup_after == node || move.delivery_after == node) {
+                fill(pickup);
+                return;
+            }
+        }
+    }
+
+    auto delivery = problem.successor_index(pickup);
+    for (auto a : added) {
+        pickup_bounds[pickup] = min(pickup_bounds[pickup], detour(a, pickup));
+        delivery_bounds[pickup] = min(delivery_bounds[pickup], detour(a, delivery));
+    }
+
+    auto worst = numeric_limits<int>::max();
+    if (cached.size() >= best_count)
+        worst = cached.back().cost;
+
+    for (auto a : added) {
+        auto b = route[positions[a] + 1];
+        auto together = arc_cost(a, pickup) + arc_cost(pickup, delivery) + arc_cost(delivery, b) - arc_cost(a, b);
+        auto pickup_into = detour(a, pickup) + delivery_bounds[pickup];
+        auto delivery_into = pickup_bounds[pickup] + detour(a, delivery);
+
+        if (together <= worst || pickup_into <= worst || delivery_into <= worst) {
+            fill(pickup);
+            return;
+        }
+    }
+}
+
+void TSPPDPairInsertion::keep_best(const unsigned int pickup, vector<TSPPDPairInsertionMove>& moves) {
+    sort(moves.begin(), moves.end(), [](const TSPPDPairInsertionMove& a, const TSPPDPairInsertionMove& b) {
+        return a.cost < b.cost || (a.cost == b.cost && a.pickup_after < b.pickup_after);
+    });
+
+    // Only the cheapest move for each pickup arc counts toward regret.
+    auto& best = cache[pickup];
+    best.clear();
+    for (auto& move : moves) {
+        if (best.size() >= best_count)
+            break;
+
+        auto seen = false;
+        for (auto& kept : best)
+            seen = seen || kept.pickup_after == move.pickup_after;
+        if (!seen)
+            best.push_back(move);
+    }
+}
+
+vector<unsigned int> TSPPDPairInsertion::apply(const unsigned int pickup, const TSPPDPairInsertionMove& move) {
+    auto delivery = problem.successor_index(pickup);
+    auto i = positions[move.pickup_after];
+    auto j = positions[move.delivery_after];
+
+    if (i == j) {
+        route.insert(route.begin() + i + 1, {pickup, delivery});
+    } else {
+        route.insert(route.begin() + j + 1, delivery);
+        route.insert(route.begin() + i + 1, pickup);
+    }
+
+    for (unsigned int k = i + 1; k < route.size(); ++k)
+        positions[route[k]] = k;
+
+    if (i == j)
+        return {move.pickup_after, pickup, delivery};
+    return {move.pickup_after, pickup, move.delivery_after, delivery};
+}
+
+int TSPPDPairInsertion::detour(const unsigned int after, const unsigned int node) const {
+    auto next = route[positions[after] + 1];
+    return arc_cost(after, node) + arc_cost(node, next) - arc_cost(after, next);
+}
@@ -0,0 +1,85 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef TSPPD_HEURISTIC_TSPPD_PAIR_INSERTION_H
+#define TSPPD_HEURISTIC_TSPPD_PAIR_INSERTION_H
+
+#include <vector>
+
+#include <tsppd/data/tsppd_problem.h>
+
+// Regret insertion of pickup and delivery pairs into a route of node indices
+// from +0 to -0. Each pair not yet in the route caches its k cheapest
+// insertions, at most one for each arc its pickup can go into. The best
+// delivery position after each pickup arc comes from a suffix minimum, so
+// filling a cache is linear in the length of the route.
+//
+// Inserting a pair only replaces the arcs out of the nodes its pickup and
+// delivery follow. Each cache also keeps lower bounds on the detours of its
+// pickup and delivery over every arc in the route. A cache is filled again
+// only if one of its insertions uses a replaced arc, or if the bounds show an
+// insertion into a new arc could match its kth cheapest. Otherwise it is
+// exactly what filling it again would give, and it is left alone.
+namespace TSPPD {
+    namespace Heuristic {
+        // Pickup goes after node pickup_after and delivery after delivery_after,
+        // directly following the pickup if the two are the same.
+        struct TSPPDPairInsertionMove {
+            int cost;
+            unsigned int pickup_after;
+            unsigned int delivery_after;
+        };
+
+        class TSPPDPairInsertion {
+        public:
+            TSPPDPairInsertion(const TSPPD::Data::TSPPDProblem& problem);
+
+            // Inserts each pair in turn, picking the one with the largest regret
+            // over its k cheapest insertions (or just the cheapest pair if k = 1).
+            void insert(std::vector<unsigned int>& route, const std::vector<unsigned int>& pickups, const unsigned int k);
+
+            // Tour through every pair built by regret-k insertion from +0 and -0.
+            std::vector<unsigned int> construct(const unsigned int k);
+
+            int arc_cost(const unsigned int from, const unsigned int to) const { return costs[from * size + to]; }
+
+        protected:
+            void fill(const unsigned int pickup);
+            void update(const unsigned int pickup, const std::vector<unsigned int>& added);
+            void keep_best(const unsigned int pickup, std::vector<TSPPDPairInsertionMove>& moves);
+
+            // Places the pair and returns the nodes with new arcs out of them.
+            std::vector<unsigned int> apply(const unsigned int pickup, const TSPPDPairInsertionMove& move);
+
+            // Cost of putting node between after and its successor in the route.
+            int detour(const unsigned int after, const unsigned int node) const;
+
+            const TSPPD::Data::TSPPDProblem& problem;
+            const unsigned int size;
+
+            const std::vector<int>& costs;    // size x size
+
+            // Route being built.
+            std::vector<unsigned int> route;
+            std::vector<int> positions;                             // or -1 if not in the route
+            unsigned int best_count;
+            std::vector<std::vector<TSPPDPairInsertionMove>> cache; // cheapest moves by pickup
+            std::vector<int> pickup_bounds;                         // lower bounds on detours into
+            std::vector<int> delivery_bounds;                       // any route arc, by pickup
+        };
+    }
+}
+
+#endif
@@ -44,8 +44,10 @@ TSPSolutionWriter::TSPSolutionWriter(
 }
 
 void TSPSolutionWriter::write_header() {
+    lock_guard<std::mutex> lock(mutex);
+
     if (format == HUMAN) {
-        cout << "instance             size   solver        threads   clock     cpu       optimal   dual      primal    nodes     fails     depth     ";
+        cout << "instance             size   solver        threads   clock     cpu       optimal   dual      primal    gap       nodes     fails     depth     ";
         for (auto opt : options)
             cout << setfill(' ') << setw(10) << left << opt.first;
         cout << endl;
@@ -55,7 +57,7 @@ void TSPSolutionWriter::write_header() {
         cout << endl;
 
     } else if (format == CSV) {
-        cout << "instance,size,solver,threads,clock,cpu,optimal,dual,primal,nodes,fails,depth";
+        cout << "instance,size,solver,threads,clock,cpu,optimal,dual,primal,gap,nodes,fails,depth";
         for (auto opt : options)
             cout << "," << opt.first;
         cout << "," << "tour" << endl;
@@ -63,6 +65,8 @@ void TSPSolutionWriter::write_header() {
 }
 
 void TSPSolutionWriter::write(const TSPPDSearchStatistics& stats, const bool force) {
+    lock_guard<std::mutex> lock(mutex);
+
     auto wall = chrono::steady_clock::now() - start_wall;
     auto wall_time = chrono::duration_cast<std::chrono::milliseconds>(wall).count() / 1000.0;
     auto wall_str = to_string(wall_time);
@@ -72,6 +76,8 @@ void TSPSolutionWriter::write(const TSPPDSearchStatistics& stats, const bool for
 
     auto dual_str = (stats.has_dual() ? to_string(stats.dual) : "");
     auto primal_str = (stats.has_primal() ? to_string(stats.primal) : "");
+    auto gap = stats.has_gap() ? stats.gap() : 0.0;
+    auto gap_str = (stats.has_gap() ? to_string(gap) : "");
 
     if (!force && last_dual_str == dual_str && last_primal_str == primal_str)
         return;
@@ -87,6 +93,12 @@ void TSPSolutionWriter::write(const TSPPDSearchStatistics& stats, const bool for
         stringstream s2;
         s2 << fixed << setprecision(4) << cpu;
         cpu_str = s2.str();
+
+        if (stats.has_gap()) {
+            stringstream s3;
+            s3 << fixed << setprecision(4) << gap;
+            gap_str = s3.str();
+        }
     }
 
     std::vector<std::string> row {
@@ -99,6 +111,7 @@ void TSPSolutionWriter::write(const TSPPDSearchStatistics& stats, const bool for
         stats.is_optimal() ? "true" : "false",
         dual_str,
         primal_str,
+        gap_str,
         stats.has_nodes() ? to_string(stats.nodes) : "",
         stats.has_fails() ? to_string(stats.fails) : "",
         stats.has_depth() ? to_string(stats.depth) : ""
@@ -20,6 +20,7 @@
 #include <chrono>
 #include <ctime>
 #include <map>
+#include <mutex>
 #include <ostream>
 
 #include <tsppd/data/tsppd_problem.h>
@@ -29,7 +30,7 @@
 namespace TSPPD {
     namespace IO {
         enum TSPSolutionFormat { HUMAN, CSV };
-        const unsigned int TSPWriterSeparatorLength = 150;
+        const unsigned int TSPWriterSeparatorLength = 160;
 
         class TSPSolutionWriter {
         public:
@@ -57,6 +58,9 @@ namespace TSPPD {
             // For avoiding duplicate output in human mode.
             std::string last_dual_str = "";
             std::string last_primal_str = "";
+
+            // Solvers may write from multiple search threads.
+            std::mutex mutex;
         };
     }
 }
@@ -0,0 +1,352 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#include <algorithm>
+#include <cmath>
+
+#include <tsppd/data/tsppd_search_statistics.h>
+#include <tsppd/solver/alns/alns_tsppd_solver.h>
+#include <tsppd/util/exception.h>
+
+using namespace TSPPD::Data;
+using namespace TSPPD::Heuristic;
+using namespace TSPPD::IO;
+using namespace TSPPD::Solver;
+using namespace TSPPD::Util;
+using namespace std;
+
+// Scores for an operator pair whose tour is a new best, improves on the
+// current tour, or is a worse tour accepted anyway.
+const double ALNS_SCORE_BEST = 33;
+const double ALNS_SCORE_BETTER = 9;
+const double ALNS_SCORE_ACCEPTED = 13;
+
+// Weights are updated from the scores every segment of iterations.
+const unsigned int ALNS_SEGMENT = 100;
+const double ALNS_REACTION = 0.1;
+
+ALNSTSPPDSolver::ALNSTSPPDSolver(
+    const TSPPDProblem& problem,
+    const map<string, string> options,
+    TSPSolutionWriter& writer) :
+    TSPSolver(problem, options, writer),
+    local_search(problem),
+    pair_insertion(problem),
+    balas_simonetti(),
+    random(),
+    start_temperature(0) {
+
+    initialize_options();
+    random.seed(seed);
+}
+
+TSPPDSolution ALNSTSPPDSolver::solve() {
+    if (iterations == 0 && time_limit == 0)
+        iterations = 10000;
+
+    auto current = pair_insertion.construct(2);
+    auto current_cost = improve(current, local_search.cost(current));
+    auto best = current;
+    auto best_cost = current_cost;
+
+    writer.write(TSPPDSearchStatistics(TSPPDSolution(problem, best)));
+    unsigned int solutions = 1;
+    stopped = solution_limit > 0 && solutions >= solution_limit;
+
+    // A tour 5% worse than the first is accepted with probability 1/2 at the start.
+    start_temperature = 0.05 * current_cost / log(2.0);
+
+    vector<double> destroy_weights(3, 1), repair_weights(3, 1);
+    vector<double> destroy_scores(3, 0), repair_scores(3, 0);
+    vector<unsigned int> destroy_uses(3, 0), repair_uses(3, 0);
+
+    auto pairs = (unsigned int) problem.pickup_indices().size();
+    auto max_removed = min(removal_size, pairs);
+    auto min_removed = min(4u, max_removed);
+
+    unsigned int iteration = 0;
+    while (pairs > 0 && !stop(iteration)) {
+        ++iteration;
+
+        auto d = select(destroy_weights);
+        auto r = select(repair_weights);
+        auto count = uniform_int_distribution<unsigned int>(min_removed, max_removed)(random);
+
+        auto route = current;
+        auto removed = destroy((ALNSDestroyOperator) d, route, count);
+        pair_insertion.insert(route, removed, r + 1);
+        auto cost = local_search.cost(route);
+
+        double score = 0;
+        if (cost < best_cost) {
+            cost = improve(route, cost);
+
+            best = current = route;
+            best_cost = current_cost = cost;
+            score = ALNS_SCORE_BEST;
+
+            TSPPDSearchStatistics stats(TSPPDSolution(problem, best));
+            stats.nodes = iteration;
+            writer.write(stats);
+
+            if (solution_limit > 0 && ++solutions >= solution_limit)
+                stopped = true;
+
+        } else if (cost < current_cost) {
+            current = route;
+            current_cost = cost;
+            score = ALNS_SCORE_BETTER;
+
+        } else {
+            auto p = exp((current_cost - cost) / temperature(iteration));
+            if (uniform_real_distribution<double>(0, 1)(random) < p) {
+                if (cost > current_cost)
+                    score = ALNS_SCORE_ACCEPTED;
+                current = route;
+                current_cost = cost;
+            }
+        }
+
+        destroy_scores[d] += score;
+        repair_scores[r] += score;
+        ++destroy_uses[d];
+        ++repair_uses[r];
+
+        if (iteration % ALNS_SEGMENT == 0) {
+            for (unsigned int i = 0; i < 3; ++i) {
+                if (destroy_uses[i] > 0)
+                    destroy_weights[i] = max(0.01,
+                        (1 - ALNS_REACTION) * destroy_weights[i] + ALNS_REACTION * destroy_scores[i] / destroy_uses[i]);
+                if (repair_uses[i] > 0)
+                    repair_weights[i] = max(0.01,
+                        (1 - ALNS_REACTION) * repair_weights[i] + ALNS_REACTION * repair_scores[i] / repair_uses[i]);
+            }
+
+            fill(destroy_scores.begin(), destroy_scores.end(), 0);
+            fill(repair_scores.begin(), repair_scores.end(), 0);
+            fill(destroy_uses.begin(), destroy_uses.end(), 0);
+            fill(repair_uses.begin(), repair_uses.end(), 0);
+        }
+    }
+
+    TSPPDSolution solution(problem, best);
+    TSPPDSearchStatistics stats(solution);
+    stats.nodes = iteration;
+    writer.write(stats, true);
+    return solution;
+}
+
+void ALNSTSPPDSolver::initialize_options() {
+    auto bs_pair = options.find("bs");
+    if (bs_pair != options.end()) {
+        int window = 0;
+        try {
+            window = stoi(bs_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("bs must be an integer");
+        }
+        // Costs and parents each take n * 2^(bs-1) * 2bs ints. That is about
+        // 80MB for bs=10 on 500 pairs, and it doubles with every step past that.
+        if (window == 1 || window < 0 || window > 10)
+            throw TSPPDException("bs must be 0 or between 2 and 10");
+        if (window > 0)
+            balas_simonetti = make_unique<TSPPDBalasSimonetti>(problem, window);
+    }
+
+    iterations = 0;
+    auto iter_pair = options.find("iter");
+    if (iter_pair != options.end()) {
+        try {
+            iterations = stoi(iter_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("iter must be an integer");
+        }
+        if (iterations < 1)
+            throw TSPPDException("iter must be >= 1");
+    }
+
+    use_local_search = true;
+    auto ls_pair = options.find("ls");
+    if (ls_pair != options.end()) {
+        if (ls_pair->second == "off")
+            use_local_search = false;
+        else if (ls_pair->second != "on")
+            throw TSPPDException("ls can be either on or off");
+    }
+
+    seed = 0;
+    auto seed_pair = options.find("seed");
+    if (seed_pair != options.end()) {
+        try {
+            seed = stoi(seed_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("seed must be an integer");
+        }
+    }
+
+    removal_size = 30;
+    auto size_pair = options.find("size");
+    if (size_pair != options.end()) {
+        try {
+            removal_size = stoi(size_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("size must be an integer");
+        }
+        if (removal_size < 1)
+            throw TSPPDException("size must be >= 1");
+    }
+}
+
+int ALNSTSPPDSolver::improve(vector<unsigned int>& route, int cost) {
+    if (use_local_search)
+        cost = local_search.improve(route);
+
+    while (balas_simonetti) {
+        auto improved = balas_simonetti->improve(route);
+        if (improved >= cost)
+            break;
+
+        cost = use_local_search ? local_search.improve(route) : improved;
+    }
+
+    return cost;
+}
+
+vector<unsigned int> ALNSTSPPDSolver::destroy(
+    const ALNSDestroyOperator op,
+    vector<unsigned int>& route,
+    const unsigned int count) {
+
+    vector<unsigned int> pickups;
+    if (op == ALNS_DESTROY_RANDOM)
+        pickups = destroy_random(route, count);
+    else if (op == ALNS_DESTROY_RELATED)
+        pickups = destroy_related(route, count);
+    else
+        pickups = destroy_worst(route, count);
+
+    vector<bool> removed(problem.nodes.size(), false);
+    for (auto pickup : pickups) {
+        removed[pickup] = true;
+        removed[problem.successor_index(pickup)] = true;
+    }
+
+    route.erase(
+        remove_if(route.begin(), route.end(), [&](unsigned int node) { return removed[node]; }),
+        route.end()
+    );
+
+    return pickups;
+}
+
+vector<unsigned int> ALNSTSPPDSolver::destroy_random(const vector<unsigned int>& route, const unsigned int count) {
+    auto pickups = problem.pickup_indices();
+    shuffle(pickups.begin(), pickups.end(), random);
+    pickups.resize(count);
+    return pickups;
+}
+
+// Shaw removal: pairs whose pickups and deliveries are close to those of a
+// pair already removed are likely to swap places usefully.
+vector<unsigned int> ALNSTSPPDSolver::destroy_related(const vector<unsigned int>& route, const unsigned int count) {
+    auto candidates = problem.pickup_indices();
+    auto first = uniform_int_distribution<size_t>(0, candidates.size() - 1)(random);
+
+    vector<unsigned int> pickups = {candidates[first]};
+    candidates.erase(candidates.begin() + first);
+
+    while (pickups.size() < count) {
+        auto base = pickups[uniform_int_distribution<size_t>(0, pickups.size() - 1)(random)];
+        auto base_delivery = problem.successor_index(base);
+
+        sort(candidates.begin(), candidates.end(), [&](unsigned int a, unsigned int b) {
+            auto ra = local_search.arc_cost(base, a) + local_search.arc_cost(base_delivery, problem.successor_index(a));
+            auto rb = local_search.arc_cost(base, b) + local_search.arc_cost(base_delivery, problem.successor_index(b));
+            return ra < rb;
+        });
+
+        auto y = uniform_real_distribution<double>(0, 1)(random);
+        auto index = min(candidates.size() - 1, (size_t) (pow(y, 6) * candidates.size()));
+        pickups.push_back(candidates[index]);
+        candidates.erase(candidates.begin() + index);
+    }
+
+    return pickups;
+}
+
+// Pairs that save the most when taken out of the route are removed first,
+// with some randomization.
+vector<unsigned int> ALNSTSPPDSolver::destroy_worst(const vector<unsigned int>& route, const unsigned int count) {
+    vector<unsigned int> positions(problem.nodes.size(), 0);
+    for (unsigned int k = 0; k < route.size(); ++k)
+        positions[route[k]] = k;
+
+    auto arc_cost = [&](unsigned int from, unsigned int to) { return local_search.arc_cost(from, to); };
+
+    vector<pair<int, unsigned int>> savings;
+    for (auto pickup : problem.pickup_indices()) {
+        auto delivery = problem.successor_index(pickup);
+        auto i = positions[pickup];
+        auto j = positions[delivery];
+
+        int saving;
+        if (j == i + 1) {
+            saving = arc_cost(route[i - 1], pickup) + arc_cost(pickup, delivery) + arc_cost(delivery, route[j + 1]) -
+                arc_cost(route[i - 1], route[j + 1]);
+        } else {
+            saving = arc_cost(route[i - 1], pickup) + arc_cost(pickup, route[i + 1]) - arc_cost(route[i - 1], route[i + 1]) +
+                arc_cost(route[j - 1], delivery) + arc_cost(delivery, route[j + 1]) - arc_cost(route[j - 1], route[j + 1]);
+        }
+
+        savings.push_back({saving, pickup});
+    }
+
+    sort(savings.begin(), savings.end(), greater<pair<int, unsigned int>>());
+
+    vector<unsigned int> pickups;
+    while (pickups.size() < count) {
+        auto y = uniform_real_distribution<double>(0, 1)(random);
+        auto index = min(savings.size() - 1, (size_t) (pow(y, 3) * savings.size()));
+        pickups.push_back(savings[index].second);
+        savings.erase(savings.begin() + index);
+    }
+
+    return pickups;
+}
+
+unsigned int ALNSTSPPDSolver::select(const vector<double>& weights) {
+    discrete_distribution<unsigned int> distribution(weights.begin(), weights.end());
+    return distribution(random);
+}
+
+// Cools geometrically to a thousandth of the start over the iteration or
+// time limit, whichever is closer.
+double ALNSTSPPDSolver::temperature(const unsigned int iteration) const {
+    double progress = 0;
+    if (iterations > 0)
+        progress = iteration / (double) iterations;
+
+    if (time_limit > 0) {
+        auto millis = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+        progress = max(progress, millis.count() / (double) time_limit);
+    }
+
+    return start_temperature * pow(0.001, min(1.0, progress));
+}
+
+bool ALNSTSPPDSolver::stop(const unsigned int iteration) {
+    check_time_limit();
+    return stopped || (iterations > 0 && iteration >= iterations);
+}
@@ -0,0 +1,101 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef TSPPD_SOLVER_ALNS_TSPPD_SOLVER_H
+#define TSPPD_SOLVER_ALNS_TSPPD_SOLVER_H
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <tsppd/heuristic/tsppd_balas_simonetti.h>
+#include <tsppd/heuristic/tsppd_local_search.h>
+#include <tsppd/heuristic/tsppd_pair_insertion.h>
+#include <tsppd/solver/tsp_solver.h>
+
+// ALNS TSPPD Solver based on:
+//
+// Stefan Ropke and David Pisinger.
+// "An adaptive large neighborhood search heuristic for the pickup and delivery
+// problem with time windows."
+// Transportation Science 40, no. 4 (2006): 455-472.
+//
+// Each iteration removes pickup and delivery pairs with a destroy operator
+// {random, related, worst} and puts them back with a repair operator {greedy,
+// regret-2, regret-3}. Operators are chosen by roulette wheel with weights
+// that adapt to how often they lead to new tours, and tours are accepted by
+// simulated annealing.
+//
+// Solver Options:
+//     bs:       window of the Balas-Simonetti neighborhood searched after local
+//               search, or 0 for none (default=0)
+//     iter:     iterations to run (default=10000, or unlimited with a time limit)
+//     ls:       improve the first and each new best tour with local search
+//               {on|off} (default=on)
+//     seed:     random seed (default=0)
+//     size:     max pairs removed in each iteration (default=30)
+namespace TSPPD {
+    namespace Solver {
+        enum ALNSDestroyOperator { ALNS_DESTROY_RANDOM, ALNS_DESTROY_RELATED, ALNS_DESTROY_WORST };
+        enum ALNSRepairOperator { ALNS_REPAIR_GREEDY, ALNS_REPAIR_REGRET_2, ALNS_REPAIR_REGRET_3 };
+
+        class ALNSTSPPDSolver : public TSPSolver {
+        public:
+            ALNSTSPPDSolver(
+                const TSPPD::Data::TSPPDProblem& problem,
+                const std::map<std::string, std::string> options,
+                TSPPD::IO::TSPSolutionWriter& writer
+            );
+
+            virtual std::string name() const { return "tsppd-alns"; }
+            TSPPD::Data::TSPPDSolution solve();
+
+        protected:
+            void initialize_options();
+
+            // Destroy operators take pairs out of the route and return their pickups.
+            std::vector<unsigned int> destroy(
+                const ALNSDestroyOperator op,
+                std::vector<unsigned int>& route,
+                const unsigned int count
+            );
+            std::vector<unsigned int> destroy_random(const std::vector<unsigned int>& route, const unsigned int count);
+            std::vector<unsigned int> destroy_related(const std::vector<unsigned int>& route, const unsigned int count);
+            std::vector<unsigned int> destroy_worst(const std::vector<unsigned int>& route, const unsigned int count);
+
+            // Runs local search and the Balas-Simonetti neighborhood in turn until
+            // neither improves the route. Returns its new cost.
+            int improve(std::vector<unsigned int>& route, int cost);
+
+            unsigned int select(const std::vector<double>& weights);
+            double temperature(const unsigned int iteration) const;
+            bool stop(const unsigned int iteration);
+
+            TSPPD::Heuristic::TSPPDLocalSearch local_search;
+            TSPPD::Heuristic::TSPPDPairInsertion pair_insertion;
+            std::unique_ptr<TSPPD::Heuristic::TSPPDBalasSimonetti> balas_simonetti;
+
+            unsigned int iterations;
+            bool use_local_search;
+            unsigned int seed;
+            unsigned int removal_size;
+
+            std::mt19937 random;
+            double start_temperature;
+       };
+    }
+}
+
+#endif
@@ -51,7 +51,7 @@ namespace TSPPD {
             const TSPPD::Data::TSPPDProblem& problem;
             std::vector<std::vector<GRBVar>> x;
             const ATSPSECType sec_type;
-            TSPPD::IO::TSPSolutionWriter writer;
+            TSPPD::IO::TSPSolutionWriter& writer;
 
             int primal;
        };
@@ -126,6 +126,11 @@ void APATSPSolver::configure_solver() {
 
     // Set thread count.
     model.set(GRB_IntParam_Threads, threads);
+
+    // Start from the heuristic tour. Gurobi fills in any other variables.
+    auto tour = initial_tour();
+    for (unsigned int i = 0; i + 1 < tour.size(); ++i)
+        x[tour[i]][tour[i + 1]].set(GRB_DoubleAttr_Start, 1);
 }
 
 TSPPDSolution APATSPSolver::solution() {
@@ -0,0 +1,239 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include <tsppd/data/tsppd_search_statistics.h>
+#include <tsppd/solver/dp/dp_tsppd_solver.h>
+#include <tsppd/util/exception.h>
+
+using namespace TSPPD::Data;
+using namespace TSPPD::IO;
+using namespace TSPPD::Solver;
+using namespace TSPPD::Util;
+using namespace std;
+
+const unsigned int DP_MAX_PAIRS = 15;
+
+const int DP_INFINITY = numeric_limits<int>::max();
+
+DPTSPPDSolver::DPTSPPDSolver(
+    const TSPPDProblem& problem,
+    const map<string, string> options,
+    TSPSolutionWriter& writer) :
+    TSPSolver(problem, options, writer),
+    size(problem.nodes.size()),
+    start_index(0),
+    end_index(problem.successor_index(0)),
+    pickups(problem.pickup_indices()),
+    deliveries(),
+    costs(problem.cost_matrix()),
+    powers(),
+    layers(),
+    values() {
+
+    if (pickups.size() > DP_MAX_PAIRS)
+        throw TSPPDException("tsppd-dp can only solve instances with up to 15 pairs");
+
+    for (auto pickup : pickups)
+        deliveries.push_back(problem.successor_index(pickup));
+
+    initialize_options();
+}
+
+TSPPDSolution DPTSPPDSolver::solve() {
+    // Reported while the states are filled, and kept if time runs out.
+    auto heuristic = initial_tour();
+
+    auto pairs = pickups.size();
+    initialize_layers();
+    values.assign(powers[pairs] * pairs, DP_INFINITY);
+
+    for (unsigned int l = 1; l < layers.size(); ++l) {
+        check_time_limit();
+        if (stopped)
+            break;
+        evaluate_layer(layers[l]);
+    }
+
+    // Without a heuristic tour, a stopped search falls back to the problem order.
+    auto order = heuristic;
+    if (!stopped) {
+        // Every pair is complete, so the last node is some delivery.
+        auto full = powers[pairs] - 1;
+        auto best_cost = DP_INFINITY;
+        unsigned int best_last = 0;
+        for (unsigned int i = 0; i < pairs; ++i) {
+            auto cost = values[full * pairs + i] + arc_cost(deliveries[i], end_index);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_last = i;
+            }
+        }
+
+        order = tour(best_last);
+    }
+
+    auto solution = order.empty() ? TSPPDSolution(problem, problem.nodes) : TSPPDSolution(problem, order);
+
+    TSPPDSearchStatistics stats(solution);
+    if (!stopped) {
+        stats.dual = stats.primal;
+        stats.optimal = true;
+    }
+    writer.write(stats, true);
+
+    return solution;
+}
+
+void DPTSPPDSolver::initialize_options() {
+    // Layers smaller than this per thread are not worth starting threads for.
+    split = 4096;
+    auto split_pair = options.find("split");
+    if (split_pair != options.end()) {
+        int states = 0;
+        try {
+            states = stoi(split_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("split must be an integer");
+        }
+        if (states < 1)
+            throw TSPPDException("split must be >= 1");
+        split = states;
+    }
+}
+
+// A code has one more node visited than the code with its last nonzero digit
+// dropped by one, so the count for each code comes from a smaller one.
+void DPTSPPDSolver::initialize_layers() {
+    auto pairs = pickups.size();
+
+    powers = {1};
+    for (unsigned int i = 0; i < pairs; ++i)
+        powers.push_back(powers.back() * 3);
+
+    vector<uint8_t> visited(powers[pairs], 0);
+    layers = vector<vector<uint32_t>>(2 * pairs + 1);
+    layers[0].push_back(0);
+
+    for (uint32_t code = 1; code < powers[pairs]; ++code) {
+        visited[code] = visited[code / 3] + code % 3;
+        layers[visited[code]].push_back(code);
+    }
+}
+
+void DPTSPPDSolver::evaluate_layer(const vector<uint32_t>& layer) {
+    auto workers_count = min((size_t) threads, layer.size() / split);
+    if (workers_count <= 1) {
+        for (auto code : layer)
+            evaluate(code);
+        return;
+    }
+
+    // States in a layer only read the layer before, so threads never share writes.
+    vector<thread> workers;
+    for (size_t t = 0; t < workers_count; ++t) {
+        workers.push_back(thread([&, t]() {
+            for (auto k = t; k < layer.size(); k += workers_count)
+                evaluate(layer[k]);
+        }));
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+// Pulls the cheapest path into each node that can be last in code from the
+// states of the code without it.
+void DPTSPPDSolver::evaluate(const uint32_t code) {
+    auto pairs = pickups.size();
+
+    unsigned int digits[DP_MAX_PAIRS];
+    auto rest = code;
+    for (unsigned int i = 0; i < pairs; ++i) {
+        digits[i] = rest % 3;
+        rest /= 3;
+    }
+
+    for (unsigned int j = 0; j < pairs; ++j) {
+        if (digits[j] == 0)
+            continue;
+
+        auto to = node(j, digits[j]);
+        auto previous = code - powers[j];
+        auto best = DP_INFINITY;
+
+        if (previous == 0) {
+            best = arc_cost(start_index, to);
+        } else {
+            --digits[j];
+            for (unsigned int i = 0; i < pairs; ++i) {
+                if (digits[i] == 0)
+                    continue;
+
+                auto value = values[previous * pairs + i];
+                if (value < DP_INFINITY)
+                    best = min(best, value + arc_cost(node(i, digits[i]), to));
+            }
+            ++digits[j];
+        }
+
+        values[code * pairs + j] = best;
+    }
+}
+
+// Walks back from the full code, finding for each state the one before it
+// whose cost plus the arc between them gives its own.
+vector<unsigned int> DPTSPPDSolver::tour(unsigned int last) const {
+    auto pairs = pickups.size();
+
+    vector<unsigned int> order = {end_index};
+    if (pairs == 0) {
+        order.push_back(start_index);
+        reverse(order.begin(), order.end());
+        return order;
+    }
+
+    vector<unsigned int> digits(pairs, 2);
+    uint32_t code = powers[pairs] - 1;
+
+    while (true) {
+        auto to = node(last, digits[last]);
+        order.push_back(to);
+
+        auto value = values[code * pairs + last];
+        code -= powers[last];
+        --digits[last];
+        if (code == 0)
+            break;
+
+        for (unsigned int i = 0; i < pairs; ++i) {
+            if (digits[i] == 0)
+                continue;
+
+            auto previous = values[code * pairs + i];
+            if (previous < DP_INFINITY && previous + arc_cost(node(i, digits[i]), to) == value) {
+                last = i;
+                break;
+            }
+        }
+    }
+
+    order.push_back(start_index);
+    reverse(order.begin(), order.end());
+    return order;
+}
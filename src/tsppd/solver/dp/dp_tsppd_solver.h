@@ -0,0 +1,87 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef TSPPD_SOLVER_DP_TSPPD_SOLVER_H
+#define TSPPD_SOLVER_DP_TSPPD_SOLVER_H
+
+#include <cstdint>
+#include <vector>
+
+#include <tsppd/solver/tsp_solver.h>
+
+// Dynamic Programming TSPPD Solver based on:
+//
+// Michael Held and Richard M. Karp.
+// "A dynamic programming approach to sequencing problems."
+// Journal of the Society for Industrial and Applied Mathematics 10, no. 1
+// (1962): 196-210.
+//
+// Visited sets are only precedence feasible if each pair has neither node,
+// just its pickup, or both visited, so a set is a base 3 code with one digit
+// per pair. The last node visited is the pickup of a pair with digit 1 or the
+// delivery of a pair with digit 2, so states are (code, pair) and there are
+// pairs * 3^pairs of them. Each state is the cheapest path from +0 through its
+// set that ends at its last node.
+//
+// States in a layer all visit the same number of nodes and only depend on the
+// layer before, so each layer is split between threads. Instances are limited
+// to 15 pairs, which takes about 860MB for state costs.
+namespace TSPPD {
+    namespace Solver {
+        class DPTSPPDSolver : public TSPSolver {
+        public:
+            DPTSPPDSolver(
+                const TSPPD::Data::TSPPDProblem& problem,
+                const std::map<std::string, std::string> options,
+                TSPPD::IO::TSPSolutionWriter& writer
+            );
+
+            virtual std::string name() const { return "tsppd-dp"; }
+            TSPPD::Data::TSPPDSolution solve();
+
+        protected:
+            void initialize_options();
+            void initialize_layers();
+            void evaluate_layer(const std::vector<uint32_t>& layer);
+            void evaluate(const uint32_t code);
+
+            // Reads the tour back from the cheapest state over every node.
+            std::vector<unsigned int> tour(unsigned int last) const;
+
+            // Node a pair has as its last visited node for a digit of 1 or 2.
+            unsigned int node(const unsigned int pair, const unsigned int digit) const {
+                return digit == 1 ? pickups[pair] : deliveries[pair];
+            }
+
+            int arc_cost(const unsigned int from, const unsigned int to) const { return costs[from * size + to]; }
+
+            const unsigned int size;
+            const unsigned int start_index;
+            const unsigned int end_index;
+
+            std::vector<unsigned int> pickups;
+            std::vector<unsigned int> deliveries;
+            const std::vector<int>& costs;      // size x size
+
+            size_t split;                       // states per thread before a layer is split
+
+            std::vector<uint32_t> powers;               // 3^pair
+            std::vector<std::vector<uint32_t>> layers;  // codes by nodes visited
+            std::vector<int> values;                    // cost of each (code, pair)
+        };
+    }
+}
+
+#endif
@@ -18,10 +18,12 @@
 
 #include <tsppd/data/tsppd_search_statistics.h>
 #include <tsppd/solver/enumerative/enumerative_tsp_solver.h>
+#include <tsppd/util/exception.h>
 
 using namespace TSPPD::Data;
 using namespace TSPPD::IO;
 using namespace TSPPD::Solver;
+using namespace TSPPD::Util;
 using namespace std;
 
 // Enumerative TSP Solver
@@ -38,7 +40,29 @@ EnumerativeTSPSolver::EnumerativeTSPSolver(
 }
 
 TSPPDSolution EnumerativeTSPSolver::solve() {
-    find_best();
+    // Only tours that improve on the heuristic one are searched for.
+    auto tour = initial_tour();
+    if (!tour.empty()) {
+        best_tour = tour;
+        best_cost = problem.cost(0, tour[tour.size() - 1]);
+        for (unsigned int i = 0; i < tour.size() - 1; ++i)
+            best_cost += problem.cost(tour[i], tour[i + 1]);
+    }
+
+    if (bitmask) {
+        initialize_bitmask();
+
+        bool precedence = false;
+        for (auto mask : required)
+            precedence = precedence || mask != 0;
+
+        if (precedence)
+            find_best_bitmask<true>(1);
+        else
+            find_best_bitmask<false>(1);
+    } else {
+        find_best();
+    }
 
     TSPPDSolution solution(problem, best_tour);
     TSPPDSearchStatistics stats(solution);
@@ -52,6 +76,13 @@ TSPPDSolution EnumerativeTSPSolver::solve() {
 }
 
 void EnumerativeTSPSolver::initialize_search() {
+    if (options["bitmask"] == "" || options["bitmask"] == "on")
+        bitmask = problem.nodes.size() <= 64;
+    else if (options["bitmask"] == "off")
+        bitmask = false;
+    else
+        throw TSPPDException("bitmask can be either on or off");
+
     for (unsigned int i = 0; i < problem.nodes.size(); ++i)
         arcs.push_back(problem.arcs(i));
     current_tour.push_back(0);
@@ -125,3 +156,76 @@ bool EnumerativeTSPSolver::feasible(TSPPDArc next) {
 
     return true;
 }
+
+void EnumerativeTSPSolver::initialize_bitmask() {
+    auto n = problem.nodes.size();
+
+    required = vector<uint64_t>(n, 0);
+    arc_to = vector<unsigned int>(n * n, 0);
+    arc_cost = vector<int>(n * n, numeric_limits<int>::max());
+    cost_matrix = vector<int>(n * n, 0);
+    bitmask_nodes = 0;
+
+    for (unsigned int i = 0; i < n; ++i) {
+        required[i] = required_mask(i);
+        for (unsigned int a = 0; a < arcs[i].size(); ++a) {
+            arc_to[i * n + a] = arcs[i][a].to_index;
+            arc_cost[i * n + a] = arcs[i][a].cost;
+            cost_matrix[i * n + arcs[i][a].to_index] = arcs[i][a].cost;
+        }
+    }
+}
+
+// Same search as find_best, with the tour kept in visited. Arcs are sorted by
+// cost, so the first one that cannot improve ends the loop.
+template <bool Precedence>
+void EnumerativeTSPSolver::find_best_bitmask(const uint64_t visited) {
+    // Checking the clock is expensive relative to a node here.
+    if ((++bitmask_nodes & 1023) == 0)
+        check_time_limit();
+    if (stopped)
+        return;
+
+    auto n = problem.nodes.size();
+    auto current = current_tour.back();
+
+    for (unsigned int index = 0; index < arcs[current].size(); ++index) {
+        auto to = arc_to[current * n + index];
+        auto cost = arc_cost[current * n + index];
+
+        if (current_cost + cost >= best_cost)
+            break;
+        if (visited & ((uint64_t) 1 << to))
+            continue;
+        if (Precedence && (required[to] & ~visited))
+            continue;
+
+        current_tour.push_back(to);
+        current_cost += cost;
+
+        if (current_tour.size() == n) {
+            // Add in final arc.
+            int final_arc_cost = cost_matrix[0 * n + to];
+            if (current_cost + final_arc_cost < best_cost) {
+                best_tour = current_tour;
+                best_cost = current_cost + final_arc_cost;
+
+                TSPPDSolution solution(problem, current_tour);
+                writer.write(solution);
+
+                // If we have a solution limit, respect it.
+                if (solution_limit > 0 && --solution_limit == 0)
+                    stopped = true;
+            }
+
+        } else {
+            find_best_bitmask<Precedence>(visited | ((uint64_t) 1 << to));
+        }
+
+        current_tour.pop_back();
+        current_cost -= cost;
+
+        if (stopped)
+            return;
+    }
+}
@@ -17,6 +17,7 @@
 #ifndef TSPPD_SOLVER_ENUMERATIVE_TSP_SOLVER_H
 #define TSPPD_SOLVER_ENUMERATIVE_TSP_SOLVER_H
 
+#include <cstdint>
 #include <map>
 #include <queue>
 #include <vector>
@@ -24,6 +25,8 @@
 #include <tsppd/data/tsppd_arc.h>
 #include <tsppd/solver/tsp_solver.h>
 
+// Solver Options:
+//     bitmask:  use uint64 masks for instances with at most 64 nodes {on|off} (default=on)
 namespace TSPPD {
     namespace Solver {
         class EnumerativeTSPSolver : public TSPSolver {
@@ -42,8 +45,22 @@ namespace TSPPD {
             void find_best();
             virtual bool feasible(TSPPD::Data::TSPPDArc next);
 
+            // Small instances keep the tour in a bitmask. Nodes required before
+            // another is visited are also kept as masks, so feasibility checks
+            // are a single bitwise and.
+            void initialize_bitmask();
+            template <bool Precedence> void find_best_bitmask(const uint64_t visited);
+            virtual uint64_t required_mask(const unsigned int node_index) const { return 0; }
+
             std::vector<std::vector<TSPPD::Data::TSPPDArc>> arcs;
 
+            bool bitmask;
+            std::vector<uint64_t> required;     // nodes that must precede each node
+            std::vector<unsigned int> arc_to;   // arcs by cost, n per node
+            std::vector<int> arc_cost;          // arc costs by cost, n per node
+            std::vector<int> cost_matrix;       // n x n arc costs
+            unsigned long bitmask_nodes;
+
             std::vector<bool> in_tour;
             std::vector<unsigned int> current_tour;
             int current_cost;
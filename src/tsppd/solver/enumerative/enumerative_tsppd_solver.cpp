@@ -43,3 +43,19 @@ bool EnumerativeTSPPDSolver::feasible(TSPPDArc next) {
 
     return EnumerativeTSPSolver::feasible(next);
 }
+
+uint64_t EnumerativeTSPPDSolver::required_mask(const unsigned int node_index) const {
+    // The end node can only follow every other node.
+    auto end_index = problem.successor_index(0);
+    if (node_index == end_index) {
+        auto n = problem.nodes.size();
+        uint64_t all = n < 64 ? ((uint64_t) 1 << n) - 1 : ~(uint64_t) 0;
+        return all & ~((uint64_t) 1 << end_index);
+    }
+
+    // Deliveries follow their pickups.
+    if (problem.has_predecessor(node_index))
+        return (uint64_t) 1 << problem.predecessor_index(node_index);
+
+    return 0;
+}
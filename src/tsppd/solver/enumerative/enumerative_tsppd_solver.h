@@ -34,6 +34,7 @@ namespace TSPPD {
 
         protected:
             bool feasible(TSPPD::Data::TSPPDArc next) override;
+            uint64_t required_mask(const unsigned int node_index) const override;
        };
     }
 }
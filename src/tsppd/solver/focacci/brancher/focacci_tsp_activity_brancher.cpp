@@ -0,0 +1,84 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#include <tsppd/solver/focacci/brancher/focacci_tsp_activity_brancher.h>
+
+using namespace Gecode;
+using namespace TSPPD::Data;
+using namespace TSPPD::Solver;
+using namespace std;
+
+FocacciTSPActivityBrancher::FocacciTSPActivityBrancher(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem,
+    IntAction action) :
+    FocacciTSPBrancher(home, next, problem),
+    action(action) { }
+
+FocacciTSPActivityBrancher::FocacciTSPActivityBrancher(Space& home, FocacciTSPActivityBrancher& b) :
+    FocacciTSPBrancher(home, b),
+    action(b.action) { }
+
+Actor* FocacciTSPActivityBrancher::copy(Space& home) {
+    return new (home) FocacciTSPActivityBrancher(home, *this);
+}
+
+size_t FocacciTSPActivityBrancher::dispose(Gecode::Space& home) {
+    action.~IntAction();
+    (void) FocacciTSPBrancher::dispose(home);
+    return sizeof(*this);
+}
+
+Choice* FocacciTSPActivityBrancher::choice(Space& home) {
+    int best_from = -1;
+    double best_score = -1;
+    unsigned int ties = 0;
+
+    for (int from = 0; from < next.size(); ++from) {
+        if (next[from].assigned())
+            continue;
+
+        auto s = score(from) / next[from].size();
+        if (s > best_score) {
+            best_from = from;
+            best_score = s;
+            ties = 1;
+        } else if (s == best_score && take_tie(ties)) {
+            best_from = from;
+        }
+    }
+
+    auto arc_index = closest_feasible_arc_index(best_from, indexes[best_from]);
+    indexes[best_from] = arc_index;
+
+    auto value = guided_value(best_from, problem.arc(best_from, arc_index).to_index);
+    return new FocacciTSPBranchChoice(*this, best_from, value);
+}
+
+void FocacciTSPActivityBrancher::post(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem,
+    IntAction action) {
+
+    (void) new (home) FocacciTSPActivityBrancher(home, next, problem, action);
+}
+
+double FocacciTSPActivityBrancher::score(const int from) const {
+    if (action.initialized())
+        return action[from];
+    return next[from].afc();
+}
@@ -0,0 +1,59 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef TSPPD_SOLVER_FOCACCI_TSP_ACTIVITY_BRANCHER_H
+#define TSPPD_SOLVER_FOCACCI_TSP_ACTIVITY_BRANCHER_H
+
+#include <tsppd/solver/focacci/brancher/focacci_tsp_brancher.h>
+
+namespace TSPPD {
+    namespace Solver {
+        // Branches on the next variable with the highest learned score per
+        // value left in its domain, fixing it to its closest feasible neighbor.
+        // Scores are either accumulated failure counts of the propagators on
+        // each variable or, given an action object, how often each domain has
+        // been pruned. Both decay over time and are shared by every copy of the
+        // space, so they carry over restarts.
+        class FocacciTSPActivityBrancher : public FocacciTSPBrancher {
+        public:
+            FocacciTSPActivityBrancher(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem,
+                Gecode::IntAction action
+            );
+
+            FocacciTSPActivityBrancher(Gecode::Space& home, FocacciTSPActivityBrancher& b);
+            virtual Gecode::Actor* copy(Gecode::Space& home);
+            virtual size_t dispose(Gecode::Space& home);
+
+            virtual Gecode::Choice* choice(Gecode::Space& home);
+
+            static void post(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem,
+                Gecode::IntAction action = Gecode::IntAction()
+            );
+
+        protected:
+            double score(const int from) const;
+
+            Gecode::IntAction action;   // uninitialized to score by afc
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,125 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <limits>
+#include <vector>
+
+#include <tsppd/solver/focacci/brancher/focacci_tsp_ap_brancher.h>
+#include <tsppd/solver/focacci/filter/focacci_tsp_assignment_filter.h>
+#include <tsppd/solver/focacci/focacci_tsp_space.h>
+#include <tsppd/util/exception.h>
+
+using namespace Gecode;
+using namespace TSPPD::Data;
+using namespace TSPPD::Solver;
+using namespace TSPPD::Util;
+using namespace std;
+
+FocacciTSPAPBrancher::FocacciTSPAPBrancher(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem,
+    FocacciTSPActorHandle<FocacciTSPAssignmentFilter>& filter) :
+    FocacciTSPRegretBrancher(home, next, problem),
+    filter(filter) { }
+
+FocacciTSPAPBrancher::FocacciTSPAPBrancher(Space& home, FocacciTSPAPBrancher& b) :
+    FocacciTSPRegretBrancher(home, b),
+    filter() {
+
+    filter.update(home, b.filter);
+}
+
+Actor* FocacciTSPAPBrancher::copy(Space& home) {
+    return new (home) FocacciTSPAPBrancher(home, *this);
+}
+
+size_t FocacciTSPAPBrancher::dispose(Gecode::Space& home) {
+    (void) FocacciTSPRegretBrancher::dispose(home);
+    return sizeof(*this);
+}
+
+Choice* FocacciTSPAPBrancher::choice(Space& home) {
+    auto ap = filter.get();
+    if (ap == nullptr)
+        return FocacciTSPRegretBrancher::choice(home);
+
+    // Read the AP solution off of the filter.
+    vector<int> successors(next.size(), -1);
+    for (int from = 0; from < next.size(); ++from) {
+        successors[from] = next[from].assigned() ? next[from].val() : ap->successor(from);
+        if (successors[from] < 0 || !next[from].in(successors[from]))
+            return FocacciTSPRegretBrancher::choice(home);
+    }
+
+    // Find the smallest subtour that still has an unassigned variable.
+    vector<bool> visited(next.size(), false);
+    vector<int> subtour;
+    for (int start = 0; start < next.size(); ++start) {
+        if (visited[start])
+            continue;
+
+        vector<int> cycle;
+        bool open = false;
+        for (int from = start; !visited[from]; from = successors[from]) {
+            visited[from] = true;
+            cycle.push_back(from);
+            open = open || !next[from].assigned();
+        }
+
+        if (open && (subtour.empty() || cycle.size() < subtour.size()))
+            subtour = cycle;
+    }
+
+    if (subtour.empty())
+        return FocacciTSPRegretBrancher::choice(home);
+
+    // Regret is the smallest reduced cost of leaving the AP arc.
+    int max_regret = -1;
+    int max_regret_from = -1;
+    unsigned int ties = 0;
+    for (auto from : subtour) {
+        if (next[from].assigned())
+            continue;
+
+        auto regret = numeric_limits<int>::max();
+        for (Int::ViewValues<Int::IntView> to(next[from]); to(); ++to)
+            if (to.val() != successors[from])
+                regret = min(regret, ap->reduced_cost(from, to.val()));
+
+        if (regret > max_regret) {
+            max_regret = regret;
+            max_regret_from = from;
+            ties = 1;
+        } else if (regret == max_regret && take_tie(ties)) {
+            max_regret_from = from;
+        }
+    }
+
+    auto value = guided_value(max_regret_from, successors[max_regret_from]);
+    return new FocacciTSPBranchChoice(*this, max_regret_from, value);
+}
+
+void FocacciTSPAPBrancher::post(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem) {
+
+    auto space = dynamic_cast<FocacciTSPSpace*>(&static_cast<Space&>(home));
+    if (space == nullptr)
+        throw TSPPDException("ap brancher must be posted in a FocacciTSPSpace");
+    (void) new (home) FocacciTSPAPBrancher(home, next, problem, space->assignment_filter());
+}
@@ -0,0 +1,58 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSP_AP_BRANCHER_H
+#define TSPPD_SOLVER_FOCACCI_TSP_AP_BRANCHER_H
+
+#include <tsppd/solver/focacci/brancher/focacci_tsp_regret_brancher.h>
+#include <tsppd/solver/focacci/filter/focacci_tsp_assignment_filter.h>
+
+namespace TSPPD {
+    namespace Solver {
+        // Branches on the AP relaxation maintained by the ap and aphk filters.
+        // Within the smallest subtour of the AP solution, it chooses the arc
+        // whose variable has the largest reduced-cost regret, so that the
+        // right branch breaks that subtour. Must be posted in a space with an
+        // ap or aphk filter. Once that filter is subsumed, such as when length
+        // is fixed, it falls back to regret branching.
+        class FocacciTSPAPBrancher : public FocacciTSPRegretBrancher {
+        public:
+            FocacciTSPAPBrancher(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem,
+                FocacciTSPActorHandle<FocacciTSPAssignmentFilter>& filter
+            );
+
+            FocacciTSPAPBrancher(Gecode::Space& home, FocacciTSPAPBrancher& b);
+            virtual Gecode::Actor* copy(Gecode::Space& home);
+            virtual size_t dispose(Gecode::Space& home);
+
+            virtual Gecode::Choice* choice(Gecode::Space& home);
+
+            static void post(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+        protected:
+            FocacciTSPActorHandle<FocacciTSPAssignmentFilter> filter;
+        };
+    }
+}
+
+#endif
@@ -15,12 +15,27 @@
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include <tsppd/solver/focacci/brancher/focacci_tsp_brancher.h>
+#include <tsppd/solver/focacci/focacci_tsp_space.h>
 
 using namespace Gecode;
 using namespace TSPPD::Data;
 using namespace TSPPD::Solver;
 using namespace std;
 
+FocacciTSPGuide::FocacciTSPGuide(const unsigned int size) : successors(size) {
+    for (auto& s : successors)
+        s.store(-1, memory_order_relaxed);
+}
+
+void FocacciTSPGuide::update(const vector<int>& tour_successors) {
+    for (size_t i = 0; i < successors.size() && i < tour_successors.size(); ++i)
+        successors[i].store(tour_successors[i], memory_order_relaxed);
+}
+
+int FocacciTSPGuide::successor(const unsigned int from) const {
+    return successors[from].load(memory_order_relaxed);
+}
+
 FocacciTSPBrancher::FocacciTSPBrancher(
     Home home,
     ViewArray<Int::IntView>& next,
@@ -28,19 +43,43 @@ FocacciTSPBrancher::FocacciTSPBrancher(
     Brancher(home),
     next(next),
     problem(problem),
-    indexes(vector<unsigned int>(next.size(), 0)) { }
+    indexes(vector<unsigned int>(next.size(), 0)),
+    random_ties(false),
+    guide(nullptr) {
+
+    // The random generator and the guide own memory outside the space.
+    home.notice(*this, AP_DISPOSE);
+
+    // Restart search asks for ties to be broken at random so that successive
+    // restarts explore different trees.
+    auto space = dynamic_cast<FocacciTSPSpace*>(&static_cast<Space&>(home));
+    if (space != nullptr && space->random_seed() > 0) {
+        random_ties = true;
+        random = Rnd(space->random_seed());
+    }
+
+    // Solution-guided search tries the incumbent's arcs first.
+    if (space != nullptr)
+        guide = space->solution_guide();
+}
 
 FocacciTSPBrancher::FocacciTSPBrancher(Space& home, FocacciTSPBrancher& b) :
     Brancher(home, b),
     next(b.next),
     problem(b.problem),
-    indexes(b.indexes) {
+    indexes(b.indexes),
+    random_ties(b.random_ties),
+    random(b.random),
+    guide(b.guide) {
 
     next.update(home, b.next);
 }
 
 size_t FocacciTSPBrancher::dispose(Gecode::Space& home) {
+    home.ignore(*this, AP_DISPOSE);
     indexes.~vector<unsigned int>();
+    random.~Rnd();
+    guide.~shared_ptr<FocacciTSPGuide>();
     (void) Brancher::dispose(home);
     return sizeof(*this);
 }
@@ -70,6 +109,18 @@ ExecStatus FocacciTSPBrancher::commit(Space& home, const Choice& c, unsigned int
 
 }
 
+// No-goods for restarts: the left branch fixes an arc and the right removes it.
+NGL* FocacciTSPBrancher::ngl(Space& home, const Choice& c, unsigned int a) const {
+    const FocacciTSPBranchChoice& bc = static_cast<const FocacciTSPBranchChoice&>(c);
+    const int index = bc.next_index;
+    const int value = bc.next_value;
+
+    if (a == 0)
+        return new (home) Int::Branch::EqNGL<Int::IntView>(home, next[index], value);
+    else
+        return new (home) Int::Branch::NqNGL<Int::IntView>(home, next[index], value);
+}
+
 void FocacciTSPBrancher::print(
     const Space& home,
     const Choice& c,
@@ -92,3 +143,18 @@ unsigned int FocacciTSPBrancher::closest_feasible_arc_index(unsigned int from, u
     }
     return index;
 }
+
+bool FocacciTSPBrancher::take_tie(unsigned int& ties) {
+    if (!random_ties)
+        return false;
+    return random(++ties) == 0;
+}
+
+int FocacciTSPBrancher::guided_value(const int from, const int value) const {
+    if (guide == nullptr)
+        return value;
+    auto successor = guide->successor(from);
+    if (successor >= 0 && next[from].in(successor))
+        return successor;
+    return value;
+}
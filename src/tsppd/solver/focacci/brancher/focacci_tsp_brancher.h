@@ -17,7 +17,9 @@
 #ifndef TSPPD_SOLVER_FOCACCI_TSP_BRANCHER_H
 #define TSPPD_SOLVER_FOCACCI_TSP_BRANCHER_H
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -29,7 +31,30 @@
 
 namespace TSPPD {
     namespace Solver {
-        enum FocacciTSPBrancherType { BRANCHER_CN, BRANCHER_SEQ_CN, BRANCHER_REGRET };
+        enum FocacciTSPBrancherType {
+            BRANCHER_ACTION,
+            BRANCHER_AFC,
+            BRANCHER_AP,
+            BRANCHER_CN,
+            BRANCHER_INC_REGRET,
+            BRANCHER_INSERTION,
+            BRANCHER_SEQ_CN,
+            BRANCHER_REGRET
+        };
+
+        // Successor of each node in the best tour found so far. Solution-guided
+        // branchers try it before their own value. The solver updates it while
+        // search engines on other threads may be reading it.
+        class FocacciTSPGuide {
+        public:
+            FocacciTSPGuide(const unsigned int size);
+
+            void update(const std::vector<int>& successors);
+            int successor(const unsigned int from) const;   // -1 if no tour yet
+
+        protected:
+            std::vector<std::atomic<int>> successors;
+        };
 
         class FocacciTSPBrancher : public Gecode::Brancher {
         public:
@@ -47,6 +72,7 @@ namespace TSPPD {
             virtual Gecode::Choice* choice(Gecode::Space& home) = 0;
             virtual Gecode::Choice* choice(const Gecode::Space&, Gecode::Archive& e);
             virtual Gecode::ExecStatus commit(Gecode::Space& home, const Gecode::Choice& c, unsigned int a);
+            virtual Gecode::NGL* ngl(Gecode::Space& home, const Gecode::Choice& c, unsigned int a) const;
 
             virtual void print(
                 const Gecode::Space& home,
@@ -58,9 +84,23 @@ namespace TSPPD {
         protected:
             unsigned int closest_feasible_arc_index(unsigned int from, unsigned int start);
 
+            // Called for the ties-th candidate tied with the best so far (the best
+            // itself counts as the first). Returns true if that candidate should
+            // replace the best, so each tied candidate is picked with equal
+            // probability. Always false unless the space randomizes ties.
+            bool take_tie(unsigned int& ties);
+
+            // The guide's successor for from if it is still in the domain, else value.
+            int guided_value(const int from, const int value) const;
+
             Gecode::ViewArray<Gecode::Int::IntView> next;
             const TSPPD::Data::TSPPDProblem& problem;
             std::vector<unsigned int> indexes;
+
+            bool random_ties;
+            Gecode::Rnd random;
+
+            std::shared_ptr<FocacciTSPGuide> guide;
         };
     }
 }
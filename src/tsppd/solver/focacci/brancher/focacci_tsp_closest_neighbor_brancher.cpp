@@ -27,10 +27,7 @@ FocacciTSPClosestNeighborBrancher::FocacciTSPClosestNeighborBrancher(
     Home home,
     ViewArray<Int::IntView>& next,
     const TSPPDProblem& problem) :
-    FocacciTSPBrancher(home, next, problem) {
-
-    home.notice(*this, AP_DISPOSE);
-}
+    FocacciTSPBrancher(home, next, problem) { }
 
 FocacciTSPClosestNeighborBrancher::FocacciTSPClosestNeighborBrancher(
     Space& home,
@@ -42,13 +39,13 @@ Actor* FocacciTSPClosestNeighborBrancher::copy(Space& home) {
 }
 
 size_t FocacciTSPClosestNeighborBrancher::dispose(Gecode::Space& home) {
-    home.ignore(*this, AP_DISPOSE);
     (void) FocacciTSPBrancher::dispose(home);
     return sizeof(*this);
 }
 
 Choice* FocacciTSPClosestNeighborBrancher::choice(Space& home) {    // Scan for max regret
     TSPPDArc best_arc;
+    unsigned int ties = 0;
 
     for (int from = 0; from < next.size(); ++from) {
         if (next[from].assigned() || next[from].size() < 2)
@@ -59,11 +56,16 @@ Choice* FocacciTSPClosestNeighborBrancher::choice(Space& home) {    // Scan for
 
         indexes[from] = arc_index;
 
-        if (arc.cost < best_arc.cost)
+        if (arc.cost < best_arc.cost) {
+            best_arc = arc;
+            ties = 1;
+        } else if (arc.cost == best_arc.cost && take_tie(ties)) {
             best_arc = arc;
+        }
     }
 
-    return new FocacciTSPBranchChoice(*this, best_arc.from_index, best_arc.to_index);
+    auto value = guided_value(best_arc.from_index, best_arc.to_index);
+    return new FocacciTSPBranchChoice(*this, best_arc.from_index, value);
 }
 
 void FocacciTSPClosestNeighborBrancher::post(
@@ -0,0 +1,66 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <tsppd/solver/focacci/brancher/focacci_tsp_incremental_regret_brancher.h>
+
+using namespace Gecode;
+using namespace TSPPD::Data;
+using namespace TSPPD::Solver;
+using namespace std;
+
+FocacciTSPIncrementalRegretBrancher::FocacciTSPIncrementalRegretBrancher(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem,
+    FocacciTSPRegretHeapHandle& heap) :
+    FocacciTSPBrancher(home, next, problem),
+    heap(heap) { }
+
+FocacciTSPIncrementalRegretBrancher::FocacciTSPIncrementalRegretBrancher(
+    Space& home,
+    FocacciTSPIncrementalRegretBrancher& b) :
+    FocacciTSPBrancher(home, b),
+    heap() {
+
+    heap.update(home, b.heap);
+}
+
+Actor* FocacciTSPIncrementalRegretBrancher::copy(Space& home) {
+    return new (home) FocacciTSPIncrementalRegretBrancher(home, *this);
+}
+
+Choice* FocacciTSPIncrementalRegretBrancher::choice(Space& home) {
+    auto regrets = heap.get();
+    auto from = regrets == nullptr ? -1 : regrets->top();
+    if (from < 0) {
+        // No variable has two arcs left to compare.
+        for (from = 0; from < next.size(); ++from)
+            if (!next[from].assigned())
+                return new FocacciTSPBranchChoice(*this, from, guided_value(from, next[from].min()));
+    }
+
+    return new FocacciTSPBranchChoice(*this, from, guided_value(from, regrets->closest(from)));
+}
+
+void FocacciTSPIncrementalRegretBrancher::post(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem) {
+
+    FocacciTSPRegretHeapHandle heap(home);
+    FocacciTSPRegretHeap::post(home, next, problem, heap);
+    (void) new (home) FocacciTSPIncrementalRegretBrancher(home, next, problem, heap);
+}
@@ -0,0 +1,54 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSP_INCREMENTAL_REGRET_BRANCHER_H
+#define TSPPD_SOLVER_FOCACCI_TSP_INCREMENTAL_REGRET_BRANCHER_H
+
+#include <tsppd/solver/focacci/brancher/focacci_tsp_brancher.h>
+#include <tsppd/solver/focacci/brancher/focacci_tsp_regret_heap.h>
+
+namespace TSPPD {
+    namespace Solver {
+        // Regret brancher that reads its choice off the top of the regret heap
+        // posted with it. The heap's advisors rescore a variable whenever its
+        // domain changes, so making a choice takes constant time.
+        class FocacciTSPIncrementalRegretBrancher : public FocacciTSPBrancher {
+        public:
+            FocacciTSPIncrementalRegretBrancher(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem,
+                FocacciTSPRegretHeapHandle& heap
+            );
+
+            FocacciTSPIncrementalRegretBrancher(Gecode::Space& home, FocacciTSPIncrementalRegretBrancher& b);
+            virtual Gecode::Actor* copy(Gecode::Space& home);
+
+            virtual Gecode::Choice* choice(Gecode::Space& home);
+
+            static void post(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+        protected:
+            FocacciTSPRegretHeapHandle heap;
+        };
+    }
+}
+
+#endif
@@ -25,10 +25,7 @@ FocacciTSPRegretBrancher::FocacciTSPRegretBrancher(
     Home home,
     ViewArray<Int::IntView>& next,
     const TSPPDProblem& problem) :
-    FocacciTSPBrancher(home, next, problem) {
-
-    home.notice(*this, AP_DISPOSE);
-}
+    FocacciTSPBrancher(home, next, problem) { }
 
 FocacciTSPRegretBrancher::FocacciTSPRegretBrancher(Space& home, FocacciTSPRegretBrancher& b) :
     FocacciTSPBrancher(home, b) { }
@@ -38,7 +35,6 @@ Actor* FocacciTSPRegretBrancher::copy(Space& home) {
 }
 
 size_t FocacciTSPRegretBrancher::dispose(Gecode::Space& home) {
-    home.ignore(*this, AP_DISPOSE);
     (void) FocacciTSPBrancher::dispose(home);
     return sizeof(*this);
 }
@@ -48,6 +44,7 @@ Choice* FocacciTSPRegretBrancher::choice(Space& home) {
     int max_regret = 0;
     int max_regret_from = 0;
     int max_regret_to = 0;
+    unsigned int ties = 0;
 
     for (int from = 0; from < next.size(); ++from) {
         if (next[from].assigned() || next[from].size() < 2)
@@ -72,10 +69,14 @@ Choice* FocacciTSPRegretBrancher::choice(Space& home) {
             max_regret = regret;
             max_regret_from = from;
             max_regret_to = arc_1.to_index;;
+            ties = 1;
+        } else if (regret == max_regret && take_tie(ties)) {
+            max_regret_from = from;
+            max_regret_to = arc_1.to_index;
         }
     }
 
-    return new FocacciTSPBranchChoice(*this, max_regret_from, max_regret_to);
+    return new FocacciTSPBranchChoice(*this, max_regret_from, guided_value(max_regret_from, max_regret_to));
 }
 
 void FocacciTSPRegretBrancher::post(
@@ -0,0 +1,234 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <algorithm>
+
+#include <tsppd/solver/focacci/brancher/focacci_tsp_regret_heap.h>
+
+using namespace Gecode;
+using namespace TSPPD::Data;
+using namespace TSPPD::Solver;
+using namespace std;
+
+FocacciTSPRegretHeap::FocacciTSPRegretHeap(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem,
+    FocacciTSPRegretHeapHandle& handle) :
+    Propagator(home),
+    next(next),
+    council(home),
+    problem(problem),
+    handle(handle),
+    indexes(vector<unsigned int>(next.size(), 0)),
+    second_indexes(vector<unsigned int>(next.size(), 0)),
+    regrets(vector<int>(next.size(), 0)),
+    heap(),
+    heap_positions(vector<int>(next.size(), -1)) {
+
+    for (int from = 0; from < next.size(); ++from) {
+        update(from);
+        if (!next[from].assigned())
+            (void) new (home) FocacciTSPIndexAdvisor(home, *this, council, next[from], from);
+    }
+
+    home.notice(*this, AP_DISPOSE);
+    this->handle.set(this);
+}
+
+FocacciTSPRegretHeap::FocacciTSPRegretHeap(Space& home, FocacciTSPRegretHeap& p) :
+    Propagator(home, p),
+    next(p.next),
+    problem(p.problem),
+    handle(),
+    indexes(p.indexes),
+    second_indexes(p.second_indexes),
+    regrets(p.regrets),
+    heap(p.heap),
+    heap_positions(p.heap_positions) {
+
+    next.update(home, p.next);
+    council.update(home, p.council);
+    handle.update(home, p.handle);
+    handle.set(this);
+}
+
+Propagator* FocacciTSPRegretHeap::copy(Space& home) {
+    return new (home) FocacciTSPRegretHeap(home, *this);
+}
+
+size_t FocacciTSPRegretHeap::dispose(Space& home) {
+    home.ignore(*this, AP_DISPOSE);
+    if (handle.get() == this)
+        handle.set(nullptr);
+    council.dispose(home);
+    indexes.~vector<unsigned int>();
+    second_indexes.~vector<unsigned int>();
+    regrets.~vector<int>();
+    heap.~vector<unsigned int>();
+    heap_positions.~vector<int>();
+    (void) Propagator::dispose(home);
+    return sizeof(*this);
+}
+
+PropCost FocacciTSPRegretHeap::cost(const Space& home, const ModEventDelta& med) const {
+    return PropCost::unary(PropCost::LO);
+}
+
+void FocacciTSPRegretHeap::reschedule(Space& home) { }
+
+ExecStatus FocacciTSPRegretHeap::advise(Space& home, Advisor& a, const Delta& d) {
+    auto& advisor = static_cast<FocacciTSPIndexAdvisor&>(a);
+    update(advisor.index);
+
+    if (next[advisor.index].assigned())
+        return home.ES_FIX_DISPOSE(council, advisor);
+    return ES_FIX;
+}
+
+ExecStatus FocacciTSPRegretHeap::propagate(Space& home, const ModEventDelta& med) {
+    if (council.empty())
+        return home.ES_SUBSUMED(*this);
+    return ES_FIX;
+}
+
+ExecStatus FocacciTSPRegretHeap::post(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem,
+    FocacciTSPRegretHeapHandle& handle) {
+
+    (void) new (home) FocacciTSPRegretHeap(home, next, problem, handle);
+    return ES_OK;
+}
+
+int FocacciTSPRegretHeap::closest(const unsigned int from) const {
+    return problem.arc(from, indexes[from]).to_index;
+}
+
+void FocacciTSPRegretHeap::update(const unsigned int from) {
+    if (next[from].assigned()) {
+        heap_remove(from);
+        return;
+    }
+
+    // Domains only shrink, so both arcs can only move further down the list.
+    auto index_1 = closest_feasible_arc_index(from, indexes[from]);
+    indexes[from] = index_1;
+    if (index_1 >= problem.arcs_size(from)) {
+        heap_remove(from);
+        return;
+    }
+
+    auto index_2 = closest_feasible_arc_index(from, max(second_indexes[from], index_1 + 1));
+    second_indexes[from] = index_2;
+    if (index_2 >= problem.arcs_size(from)) {
+        heap_remove(from);
+        return;
+    }
+
+    auto regret = problem.arc(from, index_2).cost - problem.arc(from, index_1).cost;
+    if (heap_positions[from] < 0) {
+        regrets[from] = regret;
+        heap_push(from);
+    } else if (regret > regrets[from]) {
+        regrets[from] = regret;
+        heap_sift_up(heap_positions[from]);
+    } else if (regret < regrets[from]) {
+        regrets[from] = regret;
+        heap_sift_down(heap_positions[from]);
+    }
+}
+
+unsigned int FocacciTSPRegretHeap::closest_feasible_arc_index(const unsigned int from, unsigned int index) const {
+    while (index < problem.arcs_size(from)) {
+        if (next[from].in((int) problem.arc(from, index).to_index))
+            break;
+        ++index;
+    }
+    return index;
+}
+
+bool FocacciTSPRegretHeap::heap_before(
+    const unsigned int from_1,
+    const unsigned int from_2) const {
+
+    // Break ties the way the regret brancher's scan does, so both make the
+    // same choices: the first variable wins, unless every regret is zero.
+    if (regrets[from_1] != regrets[from_2])
+        return regrets[from_1] > regrets[from_2];
+    if (regrets[from_1] == 0)
+        return from_1 > from_2;
+    return from_1 < from_2;
+}
+
+void FocacciTSPRegretHeap::heap_push(const unsigned int from) {
+    heap_positions[from] = heap.size();
+    heap.push_back(from);
+    heap_sift_up(heap.size() - 1);
+}
+
+void FocacciTSPRegretHeap::heap_remove(const unsigned int from) {
+    if (heap_positions[from] < 0)
+        return;
+
+    unsigned int position = heap_positions[from];
+    heap_swap(position, heap.size() - 1);
+    heap.pop_back();
+    heap_positions[from] = -1;
+
+    if (position < heap.size()) {
+        heap_sift_up(position);
+        heap_sift_down(position);
+    }
+}
+
+void FocacciTSPRegretHeap::heap_sift_up(unsigned int position) {
+    while (position > 0) {
+        auto parent = (position - 1) / 2;
+        if (!heap_before(heap[position], heap[parent]))
+            break;
+        heap_swap(position, parent);
+        position = parent;
+    }
+}
+
+void FocacciTSPRegretHeap::heap_sift_down(unsigned int position) {
+    while (true) {
+        auto best = position;
+        auto left = 2 * position + 1;
+        auto right = left + 1;
+
+        if (left < heap.size() && heap_before(heap[left], heap[best]))
+            best = left;
+        if (right < heap.size() && heap_before(heap[right], heap[best]))
+            best = right;
+        if (best == position)
+            break;
+
+        heap_swap(position, best);
+        position = best;
+    }
+}
+
+void FocacciTSPRegretHeap::heap_swap(
+    const unsigned int position_1,
+    const unsigned int position_2) {
+
+    swap(heap[position_1], heap[position_2]);
+    heap_positions[heap[position_1]] = position_1;
+    heap_positions[heap[position_2]] = position_2;
+}
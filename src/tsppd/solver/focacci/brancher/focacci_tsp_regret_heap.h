@@ -0,0 +1,98 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef TSPPD_SOLVER_FOCACCI_TSP_REGRET_HEAP_H
+#define TSPPD_SOLVER_FOCACCI_TSP_REGRET_HEAP_H
+
+#include <vector>
+
+#include <gecode/int.hh>
+
+#include <tsppd/data/tsppd_problem.h>
+#include <tsppd/solver/focacci/focacci_tsp_actor_handle.h>
+#include <tsppd/solver/focacci/propagator/focacci_tsp_index_advisor.h>
+
+namespace TSPPD {
+    namespace Solver {
+        class FocacciTSPRegretHeap;
+        typedef FocacciTSPActorHandle<FocacciTSPRegretHeap> FocacciTSPRegretHeapHandle;
+
+        // Keeps the regret of each next variable in an indexed max-heap for the
+        // inc-regret brancher, which finds it through a handle they share.
+        // Advisors rescore a variable when its domain changes, finding its
+        // closest and second closest arcs by scanning forward from where they
+        // were last seen, so a choice only reads the top of the heap. It never
+        // prunes, so it is never scheduled.
+        class FocacciTSPRegretHeap : public Gecode::Propagator {
+        public:
+            FocacciTSPRegretHeap(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem,
+                FocacciTSPRegretHeapHandle& handle
+            );
+
+            FocacciTSPRegretHeap(Gecode::Space& home, FocacciTSPRegretHeap& p);
+
+            virtual Gecode::Propagator* copy(Gecode::Space& home);
+            virtual size_t dispose(Gecode::Space& home);
+
+            virtual Gecode::PropCost cost(const Gecode::Space& home, const Gecode::ModEventDelta& med) const;
+            virtual void reschedule(Gecode::Space& home);
+            virtual Gecode::ExecStatus advise(Gecode::Space& home, Gecode::Advisor& a, const Gecode::Delta& d);
+            virtual Gecode::ExecStatus propagate(Gecode::Space& home, const Gecode::ModEventDelta& med);
+
+            static Gecode::ExecStatus post(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem,
+                FocacciTSPRegretHeapHandle& handle
+            );
+
+            // Variable with the largest regret, or -1 if no variable has two
+            // arcs left to compare.
+            int top() const { return heap.empty() ? -1 : heap[0]; }
+
+            // Closest remaining successor of from.
+            int closest(const unsigned int from) const;
+
+        protected:
+            void update(const unsigned int from);
+            unsigned int closest_feasible_arc_index(const unsigned int from, unsigned int index) const;
+
+            // Indexed heap operations
+            bool heap_before(const unsigned int from_1, const unsigned int from_2) const;
+            void heap_push(const unsigned int from);
+            void heap_remove(const unsigned int from);
+            void heap_sift_up(unsigned int position);
+            void heap_sift_down(unsigned int position);
+            void heap_swap(const unsigned int position_1, const unsigned int position_2);
+
+            Gecode::ViewArray<Gecode::Int::IntView> next;
+            Gecode::Council<FocacciTSPIndexAdvisor> council;
+            const TSPPD::Data::TSPPDProblem& problem;
+            FocacciTSPRegretHeapHandle handle;
+
+            std::vector<unsigned int> indexes;          // index of closest arc
+            std::vector<unsigned int> second_indexes;   // index of second closest arc
+            std::vector<int> regrets;
+
+            std::vector<unsigned int> heap;             // heap of variable indexes
+            std::vector<int> heap_positions;            // -1 if not in the heap
+        };
+    }
+}
+
+#endif
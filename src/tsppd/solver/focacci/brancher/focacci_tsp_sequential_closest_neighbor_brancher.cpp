@@ -25,10 +25,7 @@ FocacciTSPSequentialClosestNeighborBrancher::FocacciTSPSequentialClosestNeighbor
     Home home,
     ViewArray<Int::IntView>& next,
     const TSPPDProblem& problem) :
-    FocacciTSPBrancher(home, next, problem), current(0) {
-
-    home.notice(*this, AP_DISPOSE);
-}
+    FocacciTSPBrancher(home, next, problem), current(0) { }
 
 FocacciTSPSequentialClosestNeighborBrancher::FocacciTSPSequentialClosestNeighborBrancher(
     Space& home,
@@ -40,7 +37,6 @@ Actor* FocacciTSPSequentialClosestNeighborBrancher::copy(Space& home) {
 }
 
 size_t FocacciTSPSequentialClosestNeighborBrancher::dispose(Gecode::Space& home) {
-    home.ignore(*this, AP_DISPOSE);
     (void) FocacciTSPBrancher::dispose(home);
     return sizeof(*this);
 }
@@ -56,7 +52,7 @@ Choice* FocacciTSPSequentialClosestNeighborBrancher::choice(Space& home) {
 
     indexes[current] = arc_index;
 
-    return new FocacciTSPBranchChoice(*this, arc.from_index, arc.to_index);
+    return new FocacciTSPBranchChoice(*this, arc.from_index, guided_value(arc.from_index, arc.to_index));
 }
 
 void FocacciTSPSequentialClosestNeighborBrancher::post(
@@ -0,0 +1,297 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <algorithm>
+#include <limits>
+
+#include <tsppd/solver/focacci/brancher/focacci_tsppd_insertion_brancher.h>
+
+using namespace Gecode;
+using namespace TSPPD::Data;
+using namespace TSPPD::Solver;
+using namespace std;
+
+FocacciTSPPDInsertionBrancher::FocacciTSPPDInsertionBrancher(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem) :
+    FocacciTSPBrancher(home, next, problem),
+    start_index(0),
+    end_index(problem.successor_index(start_index)),
+    costs(problem.cost_matrix()),
+    planned() {
+
+    // Pairs far from the depot are inserted first, as in farthest insertion.
+    auto order = make_shared<vector<unsigned int>>(problem.pickup_indices());
+    auto distance = [&](unsigned int pickup) {
+        return cost(start_index, pickup) + cost(start_index, problem.successor_index(pickup));
+    };
+    stable_sort(order->begin(), order->end(), [&](unsigned int a, unsigned int b) {
+        return distance(a) > distance(b);
+    });
+    pickups = order;
+}
+
+FocacciTSPPDInsertionBrancher::FocacciTSPPDInsertionBrancher(Space& home, FocacciTSPPDInsertionBrancher& b) :
+    FocacciTSPBrancher(home, b),
+    start_index(b.start_index),
+    end_index(b.end_index),
+    costs(b.costs),
+    pickups(b.pickups),
+    planned(b.planned) { }
+
+Actor* FocacciTSPPDInsertionBrancher::copy(Space& home) {
+    return new (home) FocacciTSPPDInsertionBrancher(home, *this);
+}
+
+size_t FocacciTSPPDInsertionBrancher::dispose(Space& home) {
+    pickups.~shared_ptr<const vector<unsigned int>>();
+    planned.~vector<int>();
+    (void) FocacciTSPBrancher::dispose(home);
+    return sizeof(*this);
+}
+
+Choice* FocacciTSPPDInsertionBrancher::choice(Space& home) {
+    if (!plan_valid())
+        build_plan();
+
+    // Find the end of the path out of +0.
+    unsigned int tail = start_index;
+    while (next[tail].assigned())
+        tail = next[tail].val();
+
+    int value = planned[tail];
+    if (value < 0 || !next[tail].in(value)) {
+        auto arc_index = closest_feasible_arc_index(tail, indexes[tail]);
+        indexes[tail] = arc_index;
+        value = problem.arc(tail, arc_index).to_index;
+    }
+
+    return new FocacciTSPBranchChoice(*this, tail, guided_value(tail, value));
+}
+
+void FocacciTSPPDInsertionBrancher::post(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem) {
+
+    (void) new (home) FocacciTSPPDInsertionBrancher(home, next, problem);
+}
+
+// The plan is valid if the path out of +0 follows it and every remaining
+// planned arc is still in its domain.
+bool FocacciTSPPDInsertionBrancher::plan_valid() const {
+    if (planned.empty())
+        return false;
+
+    unsigned int node = start_index;
+    while (next[node].assigned()) {
+        if (planned[node] != next[node].val())
+            return false;
+        node = next[node].val();
+        if (node == start_index)
+            return true;
+    }
+
+    for (unsigned int visited = 0; node != end_index; ++visited) {
+        if (planned[node] < 0 || !next[node].in(planned[node]) || visited > planned.size())
+            return false;
+        node = planned[node];
+    }
+
+    return true;
+}
+
+void FocacciTSPPDInsertionBrancher::build_plan() {
+    unsigned int n = next.size();
+
+    // The route starts with the path out of +0 and ends with -0.
+    vector<unsigned int> route = {start_index};
+    vector<bool> in_route(n, false);
+    in_route[start_index] = true;
+    while (next[route.back()].assigned() && next[route.back()].val() != (int) start_index) {
+        route.push_back(next[route.back()].val());
+        in_route[route.back()] = true;
+    }
+
+    // Nodes can only be inserted after the tail of that path. Whatever is
+    // left of the old plan is kept, so only the nodes dropped from it have
+    // to be inserted again.
+    auto first = route.size();
+    if (!in_route[end_index]) {
+        for (auto node : repair_plan(route.back(), in_route)) {
+            route.push_back(node);
+            in_route[node] = true;
+        }
+        route.push_back(end_index);
+        in_route[end_index] = true;
+    }
+
+    // Cheapest position for a node between first and the end. Positions that
+    // keep every arc in its domain are preferred.
+    auto insert_node = [&](unsigned int node) {
+        auto best_position = route.size() - 1;
+        auto best_cost = numeric_limits<int>::max();
+        bool best_feasible = false;
+
+        for (auto k = first; k < route.size(); ++k) {
+            auto c = insertion_cost(route[k - 1], node, route[k]);
+            bool feasible = insertable(route[k - 1], node, route[k]);
+
+            if ((feasible && !best_feasible) || (feasible == best_feasible && c < best_cost)) {
+                best_position = k;
+                best_cost = c;
+                best_feasible = feasible;
+            }
+        }
+
+        route.insert(route.begin() + best_position, node);
+        in_route[node] = true;
+    };
+
+    // Deliveries whose pickups are already on the path go in first.
+    for (auto pickup : *pickups) {
+        auto delivery = problem.successor_index(pickup);
+        if (in_route[pickup] && !in_route[delivery])
+            insert_node(delivery);
+    }
+
+    // Then each remaining pair, with its pickup placed before its delivery.
+    for (auto pickup : *pickups) {
+        auto delivery = problem.successor_index(pickup);
+        if (in_route[pickup])
+            continue;
+
+        auto best_i = route.size() - 1;
+        auto best_j = route.size() - 1;
+        auto best_cost = numeric_limits<int>::max();
+        bool best_feasible = false;
+
+        for (auto i = first; i < route.size(); ++i) {
+            auto a = route[i - 1];
+            auto b = route[i];
+
+            for (auto j = i; j < route.size(); ++j) {
+                int c;
+                bool feasible;
+                if (j == i) {
+                    // Pickup and delivery together between a and b.
+                    feasible = insertable(a, pickup, delivery) && insertable(pickup, delivery, b);
+                    c = cost(a, pickup) + cost(pickup, delivery) + cost(delivery, b) - cost(a, b);
+                } else {
+                    feasible = insertable(a, pickup, b) && insertable(route[j - 1], delivery, route[j]);
+                    c = insertion_cost(a, pickup, b) + insertion_cost(route[j - 1], delivery, route[j]);
+                }
+
+                if ((feasible && !best_feasible) || (feasible == best_feasible && c < best_cost)) {
+                    best_i = i;
+                    best_j = j;
+                    best_cost = c;
+                    best_feasible = feasible;
+                }
+            }
+        }
+
+        route.insert(route.begin() + best_j, delivery);
+        route.insert(route.begin() + best_i, pickup);
+        in_route[pickup] = true;
+        in_route[delivery] = true;
+    }
+
+    // Anything else, such as nodes already linked elsewhere, goes in last.
+    for (unsigned int node = 0; node < n; ++node)
+        if (!in_route[node])
+            insert_node(node);
+
+    planned = vector<int>(n, -1);
+    for (size_t k = 1; k < route.size(); ++k)
+        planned[route[k - 1]] = route[k];
+    planned[end_index] = start_index;
+}
+
+// Nodes of the old plan after tail, in planned order, without those whose
+// arcs from the nodes before them have been removed. A pair is dropped
+// whole unless one of its nodes is on the path, so that it can be inserted
+// again with its pickup before its delivery.
+vector<unsigned int> FocacciTSPPDInsertionBrancher::repair_plan(
+    const unsigned int tail,
+    const vector<bool>& in_route) const {
+
+    if (planned.empty())
+        return {};
+
+    vector<unsigned int> order;
+    for (unsigned int node = planned[start_index], visited = 0; node != end_index && visited < planned.size(); ++visited) {
+        if (!in_route[node])
+            order.push_back(node);
+        node = planned[node];
+    }
+
+    auto partner = [&](const unsigned int index) {
+        if (problem.has_successor(index))
+            return problem.successor_index(index);
+        return problem.predecessor_index(index);
+    };
+
+    // Dropping a node joins its neighbors, so repeat until no arc is missing.
+    vector<bool> dropped(next.size(), false);
+    for (bool changed = true; changed; ) {
+        changed = false;
+
+        auto from = tail;
+        for (auto node : order) {
+            if (dropped[node])
+                continue;
+            if (!next[from].in((int) node) || dropped[partner(node)]) {
+                dropped[node] = true;
+                changed = true;
+                continue;
+            }
+            from = node;
+        }
+
+        if (from != tail && !next[from].in((int) end_index)) {
+            dropped[from] = true;
+            changed = true;
+        }
+    }
+
+    vector<unsigned int> kept;
+    for (auto node : order)
+        if (!dropped[node])
+            kept.push_back(node);
+    return kept;
+}
+
+bool FocacciTSPPDInsertionBrancher::insertable(
+    const unsigned int from,
+    const unsigned int node,
+    const unsigned int to) const {
+
+    return next[from].in((int) node) && next[node].in((int) to);
+}
+
+int FocacciTSPPDInsertionBrancher::insertion_cost(
+    const unsigned int from,
+    const unsigned int node,
+    const unsigned int to) const {
+
+    return cost(from, node) + cost(node, to) - cost(from, to);
+}
+
+int FocacciTSPPDInsertionBrancher::cost(const unsigned int from, const unsigned int to) const {
+    return costs[from * next.size() + to];
+}
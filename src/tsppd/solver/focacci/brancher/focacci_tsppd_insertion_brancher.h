@@ -0,0 +1,77 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSPPD_INSERTION_BRANCHER_H
+#define TSPPD_SOLVER_FOCACCI_TSPPD_INSERTION_BRANCHER_H
+
+#include <memory>
+#include <vector>
+
+#include <tsppd/solver/focacci/brancher/focacci_tsp_brancher.h>
+
+namespace TSPPD {
+    namespace Solver {
+        // Plans the rest of the tour by inserting each remaining pickup and
+        // delivery pair at its cheapest positions after the end of the current
+        // path out of +0, then branches on the planned arc out of that path.
+        // The plan is kept until propagation or a right branch invalidates it,
+        // so the first dive follows one insertion tour. After that only the
+        // pairs whose planned arcs were removed are inserted again.
+        class FocacciTSPPDInsertionBrancher : public FocacciTSPBrancher {
+        public:
+            FocacciTSPPDInsertionBrancher(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+            FocacciTSPPDInsertionBrancher(Gecode::Space& home, FocacciTSPPDInsertionBrancher& b);
+
+            virtual Gecode::Actor* copy(Gecode::Space& home);
+            virtual size_t dispose(Gecode::Space& home);
+
+            virtual Gecode::Choice* choice(Gecode::Space& home);
+
+            static void post(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+        protected:
+            bool plan_valid() const;
+            void build_plan();
+            std::vector<unsigned int> repair_plan(const unsigned int tail, const std::vector<bool>& in_route) const;
+
+            // True if both arcs placing node between from and to are in their domains.
+            bool insertable(const unsigned int from, const unsigned int node, const unsigned int to) const;
+            int insertion_cost(const unsigned int from, const unsigned int node, const unsigned int to) const;
+            int cost(const unsigned int from, const unsigned int to) const;
+
+            const unsigned int start_index;
+            const unsigned int end_index;
+
+            const std::vector<int>& costs;                              // n x n arc costs
+
+            // Computed at post time and shared by every copy.
+            std::shared_ptr<const std::vector<unsigned int>> pickups;   // farthest from +0 first
+
+            std::vector<int> planned;   // planned successor of each node
+        };
+    }
+}
+
+#endif
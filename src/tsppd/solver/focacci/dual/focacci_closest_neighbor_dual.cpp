@@ -14,8 +14,6 @@
 /*                                                                           */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-#include <gecode/minimodel.hh>
-
 #include <tsppd/solver/focacci/dual/focacci_closest_neighbor_dual.h>
 
 using namespace Gecode;
@@ -25,18 +23,28 @@ using namespace std;
 
 FocacciClosestNeighborDual::FocacciClosestNeighborDual(
     Space& home,
-    Int::IntView next,
-    Int::IntView closest_cost,
-    const unsigned int node_index,
+    ViewArray<Int::IntView>& next,
+    Int::IntView dual,
     const TSPPDProblem& problem) :
     Propagator(home),
     next(next),
-    closest_cost(closest_cost),
-    node_index(node_index),
+    dual(dual),
+    council(home),
     problem(problem),
-    arc_index(0) {
+    arc_indexes(vector<unsigned int>(next.size(), 0)),
+    closest_costs(vector<int>(next.size(), 0)),
+    closest_sum(0) {
+
+    for (int node_index = 0; node_index < next.size(); ++node_index) {
+        advance(node_index);
+        if (!next[node_index].assigned())
+            (void) new (home) FocacciTSPIndexAdvisor(home, *this, council, next[node_index], node_index);
+    }
+
+    home.notice(*this, AP_DISPOSE);
 
-    next.subscribe(home, *this, Int::PC_INT_DOM);
+    // Advisors only report changes, so the starting sum is posted here.
+    Int::IntView::schedule(home, *this, Int::ME_INT_DOM);
 }
 
 FocacciClosestNeighborDual::FocacciClosestNeighborDual(
@@ -44,13 +52,15 @@ FocacciClosestNeighborDual::FocacciClosestNeighborDual(
     FocacciClosestNeighborDual& p) :
     Propagator(home, p),
     next(p.next),
-    closest_cost(p.closest_cost),
-    node_index(p.node_index),
+    dual(p.dual),
     problem(p.problem),
-    arc_index(p.arc_index) {
+    arc_indexes(p.arc_indexes),
+    closest_costs(p.closest_costs),
+    closest_sum(p.closest_sum) {
 
     next.update(home, p.next);
-    closest_cost.update(home, p.closest_cost);
+    dual.update(home, p.dual);
+    council.update(home, p.council);
 }
 
 Propagator* FocacciClosestNeighborDual::copy(Space& home) {
@@ -58,41 +68,66 @@ Propagator* FocacciClosestNeighborDual::copy(Space& home) {
 }
 
 size_t FocacciClosestNeighborDual::dispose(Space& home) {
-    next.cancel(home, *this, Int::PC_INT_DOM);
+    home.ignore(*this, AP_DISPOSE);
+    council.dispose(home);
+    arc_indexes.~vector<unsigned int>();
+    closest_costs.~vector<int>();
     (void) Propagator::dispose(home);
     return sizeof(*this);
 }
 
 PropCost FocacciClosestNeighborDual::cost(const Space& home, const ModEventDelta& med) const {
-    return PropCost::linear(PropCost::HI, ((int) problem.arcs_size(node_index)) - arc_index - 1);
+    return PropCost::unary(PropCost::LO);
 }
 
 void FocacciClosestNeighborDual::reschedule(Space& home) {
-    next.reschedule(home, *this, Int::PC_INT_DOM);
+    Int::IntView::schedule(home, *this, Int::ME_INT_DOM);
+}
+
+ExecStatus FocacciClosestNeighborDual::advise(Space& home, Advisor& a, const Delta& d) {
+    auto& advisor = static_cast<FocacciTSPIndexAdvisor&>(a);
+    auto changed = advance(advisor.index);
+
+    if (next[advisor.index].assigned())
+        return changed ? home.ES_NOFIX_DISPOSE(council, advisor) : home.ES_FIX_DISPOSE(council, advisor);
+
+    return changed ? ES_NOFIX : ES_FIX;
 }
 
 ExecStatus FocacciClosestNeighborDual::propagate(Space& home, const ModEventDelta& med) {
+    GECODE_ME_CHECK(dual.gq(home, closest_sum));
+
+    if (council.empty())
+        return home.ES_SUBSUMED(*this);
+
+    return ES_FIX;
+}
+
+bool FocacciClosestNeighborDual::advance(const unsigned int node_index) {
+    // Arcs are sorted by cost, so the closest arc only moves forward.
+    auto& arc_index = arc_indexes[node_index];
     while (arc_index < problem.arcs_size(node_index)) {
         auto arc = problem.arc(node_index, arc_index);
-        if (next.in((int) arc.to_index)) {
-            if (closest_cost.gq(home, arc.cost) == Int::ME_INT_FAILED)
-                return ES_FAILED;
-            return ES_NOFIX;
+        if (next[node_index].in((int) arc.to_index)) {
+            if (arc.cost == closest_costs[node_index])
+                return false;
+            closest_sum += arc.cost - closest_costs[node_index];
+            closest_costs[node_index] = arc.cost;
+            return true;
         }
         ++arc_index;
     }
 
-    return home.ES_SUBSUMED(*this);
+    return false;
 }
 
 ExecStatus FocacciClosestNeighborDual::post(
     Space& home,
-    Int::IntView next,
-    Int::IntView closest_cost,
-    const unsigned int node_index,
+    ViewArray<Int::IntView>& next,
+    Int::IntView dual,
     const TSPPDProblem& problem) {
 
-    (void) new (home) FocacciClosestNeighborDual(home, next, closest_cost, node_index, problem);
+    (void) new (home) FocacciClosestNeighborDual(home, next, dual, problem);
     return ES_OK;
 }
 
@@ -104,24 +139,9 @@ void TSPPD::Solver::closest_neighbor_dual(
 
     GECODE_POST;
 
-    IntVarArgs costs;
-    for (unsigned int node_index = 0; node_index < problem.nodes.size(); ++node_index) {
-        // Closest successor cost
-        Gecode::IntVar closest_next_cost(home, 0,  Int::Limits::max);
-        costs << closest_next_cost;
-
-        Int::IntView next_view(next[node_index]);
-        Int::IntView closest_next_cost_view(closest_next_cost);
-        auto result = FocacciClosestNeighborDual::post(
-            home,
-            next_view,
-            closest_next_cost_view,
-            node_index,
-            problem
-        );
-        if (result != ES_OK)
-            home.fail();
-    }
+    IntVarArgs next_args(next);
+    ViewArray<Int::IntView> next_view(home, next_args);
+    Int::IntView dual_view(dual);
 
-    rel(home, dual == sum(costs));
+    GECODE_ES_FAIL(FocacciClosestNeighborDual::post(home, next_view, dual_view, problem));
 }
@@ -23,16 +23,20 @@
 
 #include <tsppd/data/tsppd_arc.h>
 #include <tsppd/data/tsppd_problem.h>
+#include <tsppd/solver/focacci/propagator/focacci_tsp_index_advisor.h>
 
 namespace TSPPD {
     namespace Solver {
+        // Bounds the dual by the sum of each node's closest feasible successor.
+        // Advisors move a node's closest arc forward when it is removed, so the
+        // sum is maintained incrementally instead of through one propagator and
+        // one cost variable per node.
         class FocacciClosestNeighborDual : public Gecode::Propagator {
         public:
             FocacciClosestNeighborDual(
                 Gecode::Space& home,
-                Gecode::Int::IntView next,
-                Gecode::Int::IntView closest_cost,
-                const unsigned int node_index,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                Gecode::Int::IntView dual,
                 const TSPPD::Data::TSPPDProblem& problem
             );
 
@@ -46,22 +50,28 @@ namespace TSPPD {
 
             virtual Gecode::PropCost cost(const Gecode::Space& home, const Gecode::ModEventDelta& med) const;
             virtual void reschedule(Gecode::Space& home);
+            virtual Gecode::ExecStatus advise(Gecode::Space& home, Gecode::Advisor& a, const Gecode::Delta& d);
             virtual Gecode::ExecStatus propagate(Gecode::Space& home, const Gecode::ModEventDelta& med);
 
             static Gecode::ExecStatus post(
                 Gecode::Space& home,
-                Gecode::Int::IntView next,
-                Gecode::Int::IntView closest_cost,
-                const unsigned int node_index,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                Gecode::Int::IntView dual,
                 const TSPPD::Data::TSPPDProblem& problem
             );
 
         protected:
-            Gecode::Int::IntView next;
-            Gecode::Int::IntView closest_cost;
-            const unsigned int node_index;
+            Gecode::ViewArray<Gecode::Int::IntView> next;
+            Gecode::Int::IntView dual;
+            Gecode::Council<FocacciTSPIndexAdvisor> council;
             const TSPPD::Data::TSPPDProblem& problem;
-            unsigned int arc_index;
+
+            std::vector<unsigned int> arc_indexes;  // closest feasible arc for each node
+            std::vector<int> closest_costs;         // cost of that arc
+            int closest_sum;
+
+            // Moves node_index to its closest remaining arc. Returns true if the sum changed.
+            bool advance(const unsigned int node_index);
         };
 
         void closest_neighbor_dual(
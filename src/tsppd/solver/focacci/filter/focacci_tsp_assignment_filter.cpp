@@ -15,6 +15,7 @@
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include <tsppd/solver/focacci/filter/focacci_tsp_assignment_filter.h>
+#include <tsppd/solver/focacci/focacci_tsp_space.h>
 
 using namespace Gecode;
 using namespace TSPPD::AP;
@@ -31,6 +32,7 @@ FocacciTSPAssignmentFilter::FocacciTSPAssignmentFilter(
     next(next),
     primal(primal),
     problem(problem),
+    handle(),
     ap(PrimalDualAPSolver(next.size())),
     unassigned() {
 
@@ -52,6 +54,13 @@ FocacciTSPAssignmentFilter::FocacciTSPAssignmentFilter(
 
     next.subscribe(home, *this, Int::PC_INT_DOM);
     home.notice(*this, AP_DISPOSE);
+
+    // Copies find the handle through their originals instead.
+    auto space = dynamic_cast<FocacciTSPSpace*>(&static_cast<Space&>(home));
+    if (space != nullptr) {
+        handle = space->assignment_filter();
+        handle.set(this);
+    }
 }
 
 FocacciTSPAssignmentFilter::FocacciTSPAssignmentFilter(Space& home, FocacciTSPAssignmentFilter& p) :
@@ -59,11 +68,14 @@ FocacciTSPAssignmentFilter::FocacciTSPAssignmentFilter(Space& home, FocacciTSPAs
     next(p.next),
     primal(p.primal),
     problem(p.problem),
+    handle(),
     ap(p.ap),
     unassigned(p.unassigned) {
 
     next.update(home, p.next);
     primal.update(home, p.primal);
+    handle.update(home, p.handle);
+    handle.set(this);
 }
 
 Propagator* FocacciTSPAssignmentFilter::copy(Space& home) {
@@ -72,6 +84,8 @@ Propagator* FocacciTSPAssignmentFilter::copy(Space& home) {
 
 size_t FocacciTSPAssignmentFilter::dispose(Space& home) {
     home.ignore(*this, AP_DISPOSE);
+    if (handle.get() == this)
+        handle.set(nullptr);
     next.cancel(home, *this, Int::PC_INT_DOM);
     ap.~PrimalDualAPSolver();
     unassigned.~vector<pair<int, int>>();
@@ -138,6 +152,17 @@ ExecStatus FocacciTSPAssignmentFilter::propagate(Space& home, const ModEventDelt
     return ES_FIX;
 }
 
+int FocacciTSPAssignmentFilter::successor(const unsigned int from) {
+    for (int to = 0; to < next.size(); ++to)
+        if (ap.get_x({from, to}))
+            return to;
+    return -1;
+}
+
+int FocacciTSPAssignmentFilter::reduced_cost(const unsigned int from, const unsigned int to) {
+    return ap.get_rc({from, to});
+}
+
 ExecStatus FocacciTSPAssignmentFilter::post(
     Home home,
     ViewArray<Int::IntView>& next,
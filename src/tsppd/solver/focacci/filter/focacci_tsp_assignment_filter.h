@@ -25,6 +25,7 @@
 
 #include <tsppd/ap/primal_dual_ap_solver.h>
 #include <tsppd/data/tsppd_problem.h>
+#include <tsppd/solver/focacci/focacci_tsp_actor_handle.h>
 
 namespace TSPPD {
     namespace Solver {
@@ -53,11 +54,18 @@ namespace TSPPD {
                 const TSPPD::Data::TSPPDProblem& problem
             );
 
+            // Relaxation from the last propagation, for use in branching.
+            int successor(const unsigned int from);
+            int reduced_cost(const unsigned int from, const unsigned int to);
+
         protected:
             Gecode::ViewArray<Gecode::Int::IntView> next;
             Gecode::Int::IntView primal;
             const TSPPD::Data::TSPPDProblem& problem;
 
+            // Shared with the ap brancher through the space.
+            FocacciTSPActorHandle<FocacciTSPAssignmentFilter> handle;
+
             TSPPD::AP::PrimalDualAPSolver ap;
             std::vector<std::pair<int, int>> unassigned;
         };
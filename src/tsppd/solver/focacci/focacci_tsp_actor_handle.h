@@ -0,0 +1,80 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSP_ACTOR_HANDLE_H
+#define TSPPD_SOLVER_FOCACCI_TSP_ACTOR_HANDLE_H
+
+#include <gecode/kernel.hh>
+
+namespace TSPPD {
+    namespace Solver {
+        // Local object holding the address of an actor in its space.
+        template <class A>
+        class FocacciTSPActorObject : public Gecode::LocalObject {
+        public:
+            FocacciTSPActorObject(Gecode::Home home) : Gecode::LocalObject(home), actor(nullptr) { }
+            FocacciTSPActorObject(Gecode::Space& home, FocacciTSPActorObject& o) :
+                Gecode::LocalObject(home, o), actor(nullptr) { }
+
+            virtual Gecode::Actor* copy(Gecode::Space& home) {
+                return new (home) FocacciTSPActorObject(home, *this);
+            }
+
+            virtual size_t dispose(Gecode::Space& home) { return sizeof(*this); }
+
+            A* actor;
+        };
+
+        // Lets one actor find another one posted with it, such as a brancher
+        // reading state kept by a propagator. Actors cannot keep pointers to
+        // each other, since every clone gets new copies of them. Handles that
+        // are updated from the same handle during a clone all get the same
+        // copy of its object, though, and the actor being found stores its
+        // new address there from its copy constructor.
+        template <class A>
+        class FocacciTSPActorHandle : public Gecode::LocalHandle {
+        public:
+            FocacciTSPActorHandle() : Gecode::LocalHandle() { }
+            FocacciTSPActorHandle(Gecode::Home home) :
+                Gecode::LocalHandle(new (home) FocacciTSPActorObject<A>(home)) { }
+            FocacciTSPActorHandle(const FocacciTSPActorHandle& h) : Gecode::LocalHandle(h) { }
+
+            FocacciTSPActorHandle& operator=(const FocacciTSPActorHandle& h) {
+                Gecode::LocalHandle::operator=(h);
+                return *this;
+            }
+
+            void update(Gecode::Space& home, FocacciTSPActorHandle& h) {
+                if (h.object() != nullptr)
+                    Gecode::LocalHandle::update(home, h);
+            }
+
+            // Null if the actor was never posted or has been disposed.
+            A* get() const { return object() == nullptr ? nullptr : handle_object()->actor; }
+            void set(A* actor) {
+                if (object() != nullptr)
+                    handle_object()->actor = actor;
+            }
+
+        protected:
+            FocacciTSPActorObject<A>* handle_object() const {
+                return static_cast<FocacciTSPActorObject<A>*>(object());
+            }
+        };
+    }
+}
+
+#endif
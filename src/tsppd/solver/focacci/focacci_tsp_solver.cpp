@@ -14,17 +14,26 @@
 /*                                                                           */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <boost/algorithm/string.hpp>
+
 #include <gecode/gist.hh>
 #include <gecode/search.hh>
 
+#include <tsppd/data/tsppd_incumbent.h>
 #include <tsppd/data/tsppd_search_statistics.h>
 #include <tsppd/solver/focacci/focacci_tsp_solver.h>
 #include <tsppd/solver/focacci/focacci_tsp_space.h>
+#include <tsppd/solver/focacci/focacci_tsp_stop.h>
 #include <tsppd/util/exception.h>
 
 using namespace Gecode;
@@ -40,20 +49,35 @@ FocacciTSPSolver::FocacciTSPSolver(
     const map<string, string> options,
     TSPSolutionWriter& writer) :
     TSPSolver(problem, options, writer),
-    discrepancy_limit(0) {
+    discrepancy_limit(0),
+    initial_order(),
+    initial_cost(numeric_limits<int>::max()) {
 
     initialize_tsp_options();
 }
 
 TSPPDSolution FocacciTSPSolver::solve() {
-    auto space = build_space();
-    space->initialize_constraints();
-    space->initialize_dual(dual_type);
-    space->initialize_brancher(brancher_type);
-    space->initialize_filter(filter_type, hk_iter);
+    if (!gist)
+        initialize_upper_bound();
+
+    if (search_engine == SEARCH_PORTFOLIO && !gist)
+        return solve_portfolio();
+    if (search_engine == SEARCH_EPS && !gist)
+        return solve_eps();
+    if (search_engine == SEARCH_BFS && !gist)
+        return solve_best_first();
+
+    auto space = initialize_space(brancher_type, filter_type);
+
+    // LNS only ends by proving optimality within a complete restart.
+    if (search_engine == SEARCH_LNS) {
+        if (time_limit == 0 && solution_limit == 0)
+            throw TSPPDException("lns requires a time or solution limit");
+        space->initialize_lns(lns_operator, lns_size, initial_order);
+    }
 
-    vector<string> best_order = problem.nodes;
-    auto best_cost = numeric_limits<int>::max();
+    vector<string> best_order = initial_order.empty() ? problem.nodes : initial_order;
+    auto best_cost = initial_cost;
 
 #ifdef GIST
     if (gist) {
@@ -69,6 +93,14 @@ TSPPDSolution FocacciTSPSolver::solve() {
     }
 #endif
 
+    // Report the root bound right away so callers can track the gap.
+    auto root_dual = initialize_root_dual(*space);
+    if (root_dual >= 0) {
+        TSPPDSearchStatistics stats;
+        stats.dual = root_dual;
+        writer.write(stats);
+    }
+
     Options o;
     o.threads = threads;
 
@@ -79,11 +111,27 @@ TSPPDSolution FocacciTSPSolver::solve() {
     if (discrepancy_limit > 0)
         o.d_l = discrepancy_limit;
 
+    // Each neighborhood is searched until it hits the fail limit.
+    if (search_engine == SEARCH_LNS)
+        o.cutoff = Cutoff::constant(lns_fails);
+
+    // Restarts follow a cutoff sequence, and branches that failed before a
+    // restart are posted as no-goods so later restarts do not repeat them.
+    if (search_engine == SEARCH_RESTART) {
+        if (restart_cutoff == RESTART_GEOMETRIC)
+            o.cutoff = Cutoff::geometric(restart_scale);
+        else
+            o.cutoff = Cutoff::luby(restart_scale);
+        o.nogoods_limit = 128;
+    }
+
     unique_ptr<Base<FocacciTSPSpace>> engine;
     if (search_engine == SEARCH_DFS)
         engine = make_unique<DFS<FocacciTSPSpace>>(space.get(), o);
     else if (search_engine == SEARCH_LDS)
         engine = make_unique<LDS<FocacciTSPSpace>>(space.get(), o);
+    else if (search_engine == SEARCH_LNS || search_engine == SEARCH_RESTART)
+        engine = make_unique<RBS<FocacciTSPSpace, BAB>>(space.get(), o);
     else
         engine = make_unique<BAB<FocacciTSPSpace>>(space.get(), o);
 
@@ -96,6 +144,7 @@ TSPPDSolution FocacciTSPSolver::solve() {
 
         auto gecode_stats = engine->statistics();
         TSPPDSearchStatistics stats(solution);
+        stats.dual = root_dual;
         stats.nodes = gecode_stats.node;
         stats.fails = gecode_stats.fail;
         stats.depth = gecode_stats.depth;
@@ -105,18 +154,25 @@ TSPPDSolution FocacciTSPSolver::solve() {
         if (cost < best_cost) {
             best_cost = cost;
             best_order = order;
+            s->update_guide();
         }
 
         if (has_solution_limit && --solution_limit <= 0) {
             stopped = true;
             break;
         }
+
+        if (gap_reached(stats)) {
+            stopped = true;
+            break;
+        }
     }
 
     TSPPDSolution solution(problem, best_order);
     auto gecode_stats = engine->statistics();
 
     TSPPDSearchStatistics stats(solution);
+    stats.dual = root_dual;
     stats.nodes = gecode_stats.node;
     stats.fails = gecode_stats.fail;
     stats.depth = gecode_stats.depth;
@@ -131,26 +187,473 @@ TSPPDSolution FocacciTSPSolver::solve() {
     return solution;
 }
 
+// Best-first search keeps open spaces in a queue ordered by their bound on
+// length. Each popped space is plunged into along its left branches, with
+// right branches going to the queue. Once the queue holds bfs-nodes spaces,
+// right branches are searched depth-first with BAB instead.
+TSPPDSolution FocacciTSPSolver::solve_best_first() {
+    auto root = initialize_space(brancher_type, filter_type);
+
+    auto root_dual = initialize_root_dual(*root);
+    if (root_dual >= 0) {
+        TSPPDSearchStatistics stats;
+        stats.dual = root_dual;
+        writer.write(stats);
+    }
+
+    // Spaces remember the incumbent cost they were last constrained by, so
+    // that constraints are only posted again after it improves.
+    struct OpenNode {
+        int bound;
+        unsigned int depth;
+        int cutoff;
+        shared_ptr<FocacciTSPSpace> space;
+    };
+
+    // Lowest bound first, then deepest first so plunges are resumed.
+    auto worse = [](const OpenNode& a, const OpenNode& b) {
+        return a.bound > b.bound || (a.bound == b.bound && a.depth < b.depth);
+    };
+    priority_queue<OpenNode, vector<OpenNode>, decltype(worse)> open(worse);
+    unique_ptr<FocacciTSPSpace> best;
+    auto best_cost = initial_cost;
+
+    if (root_dual >= 0)
+        open.push({root_dual, 0, best_cost, root});
+    auto dual = root_dual;
+
+    Search::Statistics gecode_stats;
+    atomic<bool> done(false);
+    FocacciTSPStop stop(start, time_limit, done);
+    unsigned int solutions = 0;
+
+    // Records a new incumbent and returns true if search should end.
+    auto improve = [&](FocacciTSPSpace* s) {
+        best.reset(s);
+        best_cost = best->cost().val();
+        best->update_guide();
+
+        TSPPDSolution solution(problem, best->solution());
+        TSPPDSearchStatistics stats(solution);
+        stats.dual = dual;
+        stats.nodes = gecode_stats.node;
+        stats.fails = gecode_stats.fail;
+        stats.depth = gecode_stats.depth;
+        writer.write(stats);
+
+        return (solution_limit > 0 && ++solutions >= solution_limit) || gap_reached(stats);
+    };
+
+    // Searches a subtree depth-first once the queue is full.
+    auto dive = [&](shared_ptr<FocacciTSPSpace> space) {
+        if (best)
+            space->constrain(*best);
+
+        Options o;
+        o.stop = &stop;
+
+        BAB<FocacciTSPSpace> engine(space.get(), o);
+        while (auto s = engine.next()) {
+            if (improve(s)) {
+                stopped = true;
+                break;
+            }
+        }
+
+        auto engine_stats = engine.statistics();
+        gecode_stats.node += engine_stats.node;
+        gecode_stats.fail += engine_stats.fail;
+        stopped = stopped || engine.stopped();
+    };
+
+    while (!open.empty() && !stopped) {
+        auto node = open.top();
+        open.pop();
+
+        // Everything left in the queue is at least this bound.
+        if (node.bound >= best_cost) {
+            while (!open.empty())
+                open.pop();
+            break;
+        }
+
+        if (node.bound > dual) {
+            dual = node.bound;
+
+            TSPPDSearchStatistics stats;
+            if (best)
+                stats = TSPPDSearchStatistics(TSPPDSolution(problem, best->solution()));
+            else if (!initial_order.empty())
+                stats = TSPPDSearchStatistics(TSPPDSolution(problem, initial_order));
+            stats.dual = dual;
+            writer.write(stats);
+
+            if (gap_reached(stats)) {
+                stopped = true;
+                break;
+            }
+        }
+
+        auto space = node.space;
+        auto depth = node.depth;
+        auto cutoff = node.cutoff;
+        while (!stopped) {
+            if (best && best_cost < cutoff) {
+                space->constrain(*best);
+                cutoff = best_cost;
+            }
+
+            ++gecode_stats.node;
+            gecode_stats.depth = max(gecode_stats.depth, (unsigned long int) depth);
+
+            auto status = space->status();
+            if (status == SS_FAILED) {
+                ++gecode_stats.fail;
+                break;
+            }
+
+            if (status == SS_SOLVED) {
+                if (improve(static_cast<FocacciTSPSpace*>(space->clone())))
+                    stopped = true;
+                break;
+            }
+
+            // Right branches are queued, or searched now if the queue is full.
+            auto choice = space->choice();
+            for (unsigned int a = 1; a < choice->alternatives() && !stopped; ++a) {
+                shared_ptr<FocacciTSPSpace> child(static_cast<FocacciTSPSpace*>(space->clone()));
+                child->commit(*choice, a);
+
+                if (open.size() >= bfs_nodes)
+                    dive(child);
+                else if (child->status() != SS_FAILED)
+                    open.push({child->cost().min(), depth + 1, cutoff, child});
+                else
+                    ++gecode_stats.fail;
+            }
+
+            space->commit(*choice, 0);
+            delete choice;
+            ++depth;
+
+            check_time_limit();
+        }
+    }
+
+    check_time_limit();
+
+    auto best_order = best ? best->solution() : initial_order;
+    TSPPDSolution solution(problem, best_order.empty() ? problem.nodes : best_order);
+
+    TSPPDSearchStatistics stats(solution);
+    stats.dual = dual;
+    stats.nodes = gecode_stats.node;
+    stats.fails = gecode_stats.fail;
+    stats.depth = gecode_stats.depth;
+
+    if (!stopped && open.empty()) {
+        stats.dual = stats.primal;
+        stats.optimal = true;
+    }
+
+    writer.write(stats, true);
+    return solution;
+}
+
+TSPPDSolution FocacciTSPSolver::solve_eps() {
+    TSPPDIncumbent incumbent(problem);
+    if (!initial_order.empty())
+        incumbent.improve(initial_order, initial_cost);
+
+    auto root = initialize_space(brancher_type, filter_type);
+    root->initialize_incumbent(incumbent);
+
+    auto root_dual = initialize_root_dual(*root);
+    if (root_dual >= 0) {
+        TSPPDSearchStatistics stats;
+        stats.dual = root_dual;
+        writer.write(stats);
+    }
+
+    // Subproblems are generated up front and handed out to threads in order of
+    // their bounds as threads become free.
+    auto subproblems = root->decompose(eps_depth);
+
+    atomic<bool> done(false);
+    atomic<bool> complete(true);
+    atomic<size_t> next_subproblem(0);
+    atomic<unsigned int> solutions(0);
+
+    // Cloning touches the root, so only one thread may clone it at a time.
+    mutex root_mutex;
+
+    mutex stats_mutex;
+    Search::Statistics gecode_stats;
+
+    vector<thread> workers;
+    for (unsigned int t = 0; t < max(1u, threads); ++t) {
+        workers.push_back(thread([&]() {
+            FocacciTSPStop stop(start, time_limit, done);
+
+            Options o;
+            o.threads = 1;
+            o.stop = &stop;
+
+            while (!done) {
+                auto index = next_subproblem++;
+                if (index >= subproblems.size())
+                    break;
+
+                unique_ptr<FocacciTSPSpace> space;
+                {
+                    lock_guard<mutex> lock(root_mutex);
+                    space.reset(static_cast<FocacciTSPSpace*>(root->clone()));
+                }
+                space->initialize_path(subproblems[index].path);
+
+                BAB<FocacciTSPSpace> engine(space.get(), o);
+                while (auto s = unique_ptr<FocacciTSPSpace>(engine.next())) {
+                    auto order = s->solution();
+                    auto cost = s->cost().val();
+
+                    if (cost >= incumbent.cost())
+                        continue;
+
+                    TSPPDSolution solution(problem, order);
+
+                    auto engine_stats = engine.statistics();
+                    TSPPDSearchStatistics stats(solution);
+                    stats.dual = root_dual;
+                    stats.nodes = engine_stats.node;
+                    stats.fails = engine_stats.fail;
+                    stats.depth = engine_stats.depth;
+
+                    // Another thread may improve between the check above and this one.
+                    auto report = [&] {
+                        s->update_guide();
+                        writer.write(stats);
+                    };
+                    if (!incumbent.improve(order, cost, report))
+                        continue;
+
+                    if ((solution_limit > 0 && ++solutions >= solution_limit) || gap_reached(stats)) {
+                        complete = false;
+                        done = true;
+                        break;
+                    }
+                }
+
+                if (engine.stopped())
+                    complete = false;
+
+                lock_guard<mutex> lock(stats_mutex);
+                auto engine_stats = engine.statistics();
+                gecode_stats.node += engine_stats.node;
+                gecode_stats.fail += engine_stats.fail;
+                gecode_stats.depth = max(gecode_stats.depth, engine_stats.depth);
+
+                if (eps_log) {
+                    TSPPDSearchStatistics stats;
+                    if (incumbent.has_solution())
+                        stats = TSPPDSearchStatistics(TSPPDSolution(problem, incumbent.order()));
+                    stats.dual = root_dual;
+                    stats.nodes = engine_stats.node;
+                    stats.fails = engine_stats.fail;
+                    stats.depth = engine_stats.depth;
+                    writer.write(stats, true);
+                }
+            }
+        }));
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    TSPPDSolution solution(problem, incumbent.has_solution() ? incumbent.order() : problem.nodes);
+
+    TSPPDSearchStatistics stats(solution);
+    stats.dual = root_dual;
+    stats.nodes = gecode_stats.node;
+    stats.fails = gecode_stats.fail;
+    stats.depth = gecode_stats.depth;
+
+    // Every subproblem has to be searched to prove optimality.
+    stopped = !complete || next_subproblem < subproblems.size();
+    if (!stopped) {
+        stats.dual = stats.primal;
+        stats.optimal = true;
+    }
+
+    writer.write(stats, true);
+    return solution;
+}
+
+TSPPDSolution FocacciTSPSolver::solve_portfolio() {
+    TSPPDIncumbent incumbent(problem);
+    if (!initial_order.empty())
+        incumbent.improve(initial_order, initial_cost);
+
+    // Spaces are set up here and then each one is searched by its own engine.
+    vector<shared_ptr<FocacciTSPSpace>> spaces;
+    for (auto asset : portfolio) {
+        auto space = initialize_space(asset.brancher_type, asset.filter_type);
+        space->initialize_incumbent(incumbent);
+        spaces.push_back(space);
+    }
+
+    // Every asset shares the same model, so their root bounds are valid
+    // together and the best of them is reported.
+    auto root_dual = -1;
+    for (auto space : spaces)
+        root_dual = max(root_dual, initialize_root_dual(*space));
+
+    if (root_dual >= 0) {
+        TSPPDSearchStatistics stats;
+        stats.dual = root_dual;
+        writer.write(stats);
+    }
+
+    // Available threads are split evenly across assets.
+    unsigned int asset_threads = max(1u, threads / (unsigned int) portfolio.size());
+
+    atomic<bool> done(false);
+    atomic<bool> optimal(false);
+    atomic<unsigned int> solutions(0);
+
+    mutex stats_mutex;
+    Search::Statistics gecode_stats;
+
+    vector<thread> workers;
+    for (auto space : spaces) {
+        workers.push_back(thread([&, space]() {
+            FocacciTSPStop stop(start, time_limit, done);
+
+            Options o;
+            o.threads = asset_threads;
+            o.stop = &stop;
+
+            BAB<FocacciTSPSpace> engine(space.get(), o);
+
+            bool exhausted = true;
+            while (auto s = unique_ptr<FocacciTSPSpace>(engine.next())) {
+                auto order = s->solution();
+                auto cost = s->cost().val();
+
+                if (cost >= incumbent.cost())
+                    continue;
+
+                TSPPDSolution solution(problem, order);
+
+                auto engine_stats = engine.statistics();
+                TSPPDSearchStatistics stats(solution);
+                stats.dual = root_dual;
+                stats.nodes = engine_stats.node;
+                stats.fails = engine_stats.fail;
+                stats.depth = engine_stats.depth;
+
+                // Another thread may improve between the check above and this one.
+                auto report = [&] {
+                    s->update_guide();
+                    writer.write(stats);
+                };
+                if (!incumbent.improve(order, cost, report))
+                    continue;
+
+                if (solution_limit > 0 && ++solutions >= solution_limit) {
+                    exhausted = false;
+                    break;
+                }
+
+                if (gap_reached(stats)) {
+                    exhausted = false;
+                    break;
+                }
+            }
+
+            // An engine that runs out of nodes has proven the incumbent optimal,
+            // so the rest of the portfolio can stop.
+            if (exhausted && !engine.stopped())
+                optimal = true;
+            done = true;
+
+            lock_guard<mutex> lock(stats_mutex);
+            auto engine_stats = engine.statistics();
+            gecode_stats.node += engine_stats.node;
+            gecode_stats.fail += engine_stats.fail;
+            gecode_stats.depth = max(gecode_stats.depth, engine_stats.depth);
+        }));
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    TSPPDSolution solution(problem, incumbent.has_solution() ? incumbent.order() : problem.nodes);
+
+    TSPPDSearchStatistics stats(solution);
+    stats.dual = root_dual;
+    stats.nodes = gecode_stats.node;
+    stats.fails = gecode_stats.fail;
+    stats.depth = gecode_stats.depth;
+
+    stopped = !optimal;
+    if (!stopped) {
+        stats.dual = stats.primal;
+        stats.optimal = true;
+    }
+
+    writer.write(stats, true);
+    return solution;
+}
+
 void FocacciTSPSolver::initialize_tsp_options() {
+    initialize_option_bfs();
     initialize_option_brancher();
     initialize_option_discrepancy_limit();
     initialize_option_dual_bound();
+    initialize_option_eps();
     initialize_option_filter();
+    initialize_option_gap();
     initialize_option_gist();
+    initialize_option_guided();
     initialize_option_hk_iter();
     initialize_option_search();
+    initialize_option_lns();
+    initialize_option_portfolio();
+    initialize_option_restart();
+}
+
+void FocacciTSPSolver::initialize_option_bfs() {
+    bfs_nodes = 10000;
+    auto bfs_nodes_pair = options.find("bfs-nodes");
+    if (bfs_nodes_pair != options.end()) {
+        try {
+            bfs_nodes = stoi(bfs_nodes_pair->second);
+         } catch (exception &e) {
+            throw TSPPDException("bfs-nodes must be an integer");
+         }
+        if (bfs_nodes < 1)
+            throw TSPPDException("bfs-nodes must be >= 1");
+    }
 }
 
 void FocacciTSPSolver::initialize_option_brancher() {
     brancher_type = BRANCHER_REGRET;
     auto brancher_pair = options.find("brancher");
-    if (brancher_pair != options.end()) {
-        if (brancher_pair->second == "cn")
-            brancher_type = BRANCHER_CN;
-        else if (brancher_pair->second == "seq-cn")
-            brancher_type = BRANCHER_SEQ_CN;
-        else if (brancher_pair->second != "regret")
-            throw TSPPDException("invalid brancher type '" + brancher_pair->second + "'");
+    if (brancher_pair != options.end())
+        brancher_type = parse_brancher_type(brancher_pair->second);
+
+    decay = 0.99;
+    auto decay_pair = options.find("decay");
+    if (decay_pair != options.end()) {
+        if (brancher_type != BRANCHER_ACTION && brancher_type != BRANCHER_AFC)
+            throw TSPPDException("decay requires brancher=action or brancher=afc");
+        try {
+            decay = stod(decay_pair->second);
+         } catch (exception &e) {
+            throw TSPPDException("decay must be a number");
+         }
+        if (decay <= 0 || decay > 1)
+            throw TSPPDException("decay must be > 0 and <= 1");
     }
 }
 
@@ -179,25 +682,62 @@ void FocacciTSPSolver::initialize_option_dual_bound() {
     }
 }
 
+void FocacciTSPSolver::initialize_option_eps() {
+    eps_depth = 2;
+    auto eps_depth_pair = options.find("eps-depth");
+    if (eps_depth_pair != options.end()) {
+        try {
+            eps_depth = stoi(eps_depth_pair->second);
+         } catch (exception &e) {
+            throw TSPPDException("eps-depth must be an integer");
+         }
+        if (eps_depth < 1)
+            throw TSPPDException("eps-depth must be >= 1");
+    }
+
+    eps_log = false;
+    auto eps_log_pair = options.find("eps-log");
+    if (eps_log_pair != options.end()) {
+        if (eps_log_pair->second == "on")
+            eps_log = true;
+        else if (eps_log_pair->second != "off")
+            throw TSPPDException("eps-log can be either on or off");
+    }
+}
+
 void FocacciTSPSolver::initialize_option_filter() {
-    if (options["filter"] == "ap")
-        filter_type = FOCACCI_FILTER_AP;
-    else if (options["filter"] == "aphk")
-        filter_type = FOCACCI_FILTER_APHK;
-    else if (options["filter"] == "hk")
-        filter_type = FOCACCI_FILTER_HK;
-    else if (options["filter"] == "hkap")
-        filter_type = FOCACCI_FILTER_HKAP;
-    else if (options["filter"] == "" || options["filter"] == "none")
-        filter_type = FOCACCI_FILTER_NONE;
-    else
-        throw TSPPDException("filter can be either ap, aphk, hk, hkap, or none");
+    filter_type = parse_filter_type(options["filter"]);
+}
+
+void FocacciTSPSolver::initialize_option_gap() {
+    gap_limit = 0;
+    auto gap_pair = options.find("gap");
+    if (gap_pair != options.end()) {
+        try {
+            gap_limit = stod(gap_pair->second);
+         } catch (exception &e) {
+            throw TSPPDException("gap must be a number");
+         }
+        if (gap_limit <= 0)
+            throw TSPPDException("gap must be > 0");
+    }
 }
 
 void FocacciTSPSolver::initialize_option_gist() {
     gist = options.find("gist") != options.end();
 }
 
+void FocacciTSPSolver::initialize_option_guided() {
+    guide = nullptr;
+    auto guided_pair = options.find("guided");
+    if (guided_pair != options.end()) {
+        if (guided_pair->second == "on")
+            guide = make_shared<FocacciTSPGuide>(problem.nodes.size());
+        else if (guided_pair->second != "off")
+            throw TSPPDException("guided can be either on or off");
+    }
+}
+
 void FocacciTSPSolver::initialize_option_hk_iter() {
     hk_iter = 10;
     auto hk_iter_pair = options.find("hk-iter");
@@ -212,19 +752,210 @@ void FocacciTSPSolver::initialize_option_hk_iter() {
     }
 }
 
+void FocacciTSPSolver::initialize_option_lns() {
+    lns_operator = LNS_RELATED;
+    auto lns_op_pair = options.find("lns-op");
+    if (lns_op_pair != options.end()) {
+        if (lns_op_pair->second == "random")
+            lns_operator = LNS_RANDOM;
+        else if (lns_op_pair->second == "worst")
+            lns_operator = LNS_WORST;
+        else if (lns_op_pair->second != "related")
+            throw TSPPDException("invalid lns operator '" + lns_op_pair->second + "'");
+    }
+
+    lns_size = 10;
+    auto lns_size_pair = options.find("lns-size");
+    if (lns_size_pair != options.end()) {
+        try {
+            lns_size = stoi(lns_size_pair->second);
+         } catch (exception &e) {
+            throw TSPPDException("lns-size must be an integer");
+         }
+        if (lns_size < 1)
+            throw TSPPDException("lns-size must be >= 1");
+    }
+
+    lns_fails = 200;
+    auto lns_fails_pair = options.find("lns-fails");
+    if (lns_fails_pair != options.end()) {
+        try {
+            lns_fails = stoi(lns_fails_pair->second);
+         } catch (exception &e) {
+            throw TSPPDException("lns-fails must be an integer");
+         }
+        if (lns_fails < 1)
+            throw TSPPDException("lns-fails must be >= 1");
+    }
+}
+
+void FocacciTSPSolver::initialize_option_portfolio() {
+    auto portfolio_pair = options.find("portfolio");
+    if (portfolio_pair == options.end()) {
+        portfolio = {
+            { BRANCHER_REGRET, filter_type },
+            { BRANCHER_CN,     filter_type },
+            { BRANCHER_SEQ_CN, filter_type }
+        };
+        return;
+    }
+
+    if (search_engine != SEARCH_PORTFOLIO)
+        throw TSPPDException("portfolio requires search=portfolio");
+
+    // Assets are given as brancher[/filter] separated by colons.
+    vector<string> asset_strings;
+    boost::algorithm::split(asset_strings, portfolio_pair->second, boost::is_any_of(":"));
+
+    portfolio.clear();
+    for (auto asset_string : asset_strings) {
+        vector<string> parts;
+        boost::algorithm::split(parts, asset_string, boost::is_any_of("/"));
+        if (parts.size() > 2)
+            throw TSPPDException("invalid portfolio asset '" + asset_string + "'");
+
+        FocacciTSPPortfolioAsset asset;
+        asset.brancher_type = parse_brancher_type(parts[0]);
+        asset.filter_type = parts.size() > 1 ? parse_filter_type(parts[1]) : filter_type;
+        portfolio.push_back(asset);
+    }
+}
+
+void FocacciTSPSolver::initialize_option_restart() {
+    restart_cutoff = RESTART_LUBY;
+    auto restart_pair = options.find("restart");
+    if (restart_pair != options.end()) {
+        if (search_engine != SEARCH_RESTART)
+            throw TSPPDException("restart requires search=restart");
+        if (restart_pair->second == "geometric")
+            restart_cutoff = RESTART_GEOMETRIC;
+        else if (restart_pair->second != "luby")
+            throw TSPPDException("invalid restart cutoff '" + restart_pair->second + "'");
+    }
+
+    restart_scale = 100;
+    auto restart_scale_pair = options.find("restart-scale");
+    if (restart_scale_pair != options.end()) {
+        try {
+            restart_scale = stoi(restart_scale_pair->second);
+         } catch (exception &e) {
+            throw TSPPDException("restart-scale must be an integer");
+         }
+        if (restart_scale < 1)
+            throw TSPPDException("restart-scale must be >= 1");
+    }
+}
+
 void FocacciTSPSolver::initialize_option_search() {
     search_engine = SEARCH_BAB;
     auto search_pair = options.find("search");
     if (search_pair != options.end()) {
-        if (search_pair->second == "dfs")
+        if (search_pair->second == "bfs")
+            search_engine = SEARCH_BFS;
+        else if (search_pair->second == "dfs")
             search_engine = SEARCH_DFS;
+        else if (search_pair->second == "eps")
+            search_engine = SEARCH_EPS;
         else if (search_pair->second == "lds")
             search_engine = SEARCH_LDS;
+        else if (search_pair->second == "lns")
+            search_engine = SEARCH_LNS;
+        else if (search_pair->second == "portfolio")
+            search_engine = SEARCH_PORTFOLIO;
+        else if (search_pair->second == "restart")
+            search_engine = SEARCH_RESTART;
         else if (search_pair->second != "bab")
             throw TSPPDException("invalid search engine '" + search_pair->second + "'");
     }
 }
 
+FocacciTSPBrancherType FocacciTSPSolver::parse_brancher_type(const string& brancher) const {
+    if (brancher == "action")
+        return BRANCHER_ACTION;
+    else if (brancher == "afc")
+        return BRANCHER_AFC;
+    else if (brancher == "ap")
+        return BRANCHER_AP;
+    else if (brancher == "cn")
+        return BRANCHER_CN;
+    else if (brancher == "inc-regret")
+        return BRANCHER_INC_REGRET;
+    else if (brancher == "insertion")
+        return BRANCHER_INSERTION;
+    else if (brancher == "regret")
+        return BRANCHER_REGRET;
+    else if (brancher == "seq-cn")
+        return BRANCHER_SEQ_CN;
+    throw TSPPDException("invalid brancher type '" + brancher + "'");
+}
+
+FocacciTSPFilterType FocacciTSPSolver::parse_filter_type(const string& filter) const {
+    if (filter == "ap")
+        return FOCACCI_FILTER_AP;
+    else if (filter == "aphk")
+        return FOCACCI_FILTER_APHK;
+    else if (filter == "hk")
+        return FOCACCI_FILTER_HK;
+    else if (filter == "hkap")
+        return FOCACCI_FILTER_HKAP;
+    else if (filter == "" || filter == "none")
+        return FOCACCI_FILTER_NONE;
+    throw TSPPDException("filter can be either ap, aphk, hk, hkap, or none");
+}
+
+void FocacciTSPSolver::warm_start(const TSPPDSolution& solution) {
+    initial_order = solution.order;
+    initial_cost = solution.cost;
+}
+
+void FocacciTSPSolver::initialize_upper_bound() {
+    // A warm start tour is kept in place of a new heuristic one.
+    if (!initial_order.empty())
+        return;
+
+    auto tour = initial_tour();
+    if (tour.empty())
+        return;
+
+    TSPPDSolution solution(problem, tour);
+    initial_order = solution.order;
+    initial_cost = solution.cost;
+}
+
+int FocacciTSPSolver::initialize_root_dual(FocacciTSPSpace& space) {
+    if (space.status() == SS_FAILED)
+        return -1;
+    return space.cost().min();
+}
+
+bool FocacciTSPSolver::gap_reached(const TSPPDSearchStatistics& stats) const {
+    return gap_limit > 0 && stats.has_gap() && stats.gap() <= gap_limit;
+}
+
+shared_ptr<FocacciTSPSpace> FocacciTSPSolver::initialize_space(
+    const FocacciTSPBrancherType brancher,
+    const FocacciTSPFilterType filter) {
+
+    // The ap brancher reads its relaxation off of the filter.
+    if (brancher == BRANCHER_AP && filter != FOCACCI_FILTER_AP && filter != FOCACCI_FILTER_APHK)
+        throw TSPPDException("brancher=ap requires filter=ap or aphk");
+
+    auto space = build_space();
+    space->initialize_constraints();
+    space->initialize_dual(dual_type);
+    if (!initial_order.empty())
+        space->initialize_upper_bound(initial_cost);
+
+    if (search_engine == SEARCH_RESTART)
+        space->initialize_random_ties(1);
+    space->initialize_decay(decay);
+    space->initialize_guide(guide);
+
+    space->initialize_brancher(brancher);
+    space->initialize_filter(filter, hk_iter);
+    return space;
+}
+
 shared_ptr<FocacciTSPSpace> FocacciTSPSolver::build_space() {
     auto space = make_shared<FocacciTSPSpace>(problem);
     return space;
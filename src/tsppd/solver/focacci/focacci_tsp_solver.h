@@ -18,8 +18,11 @@
 #define TSPPD_SOLVER_FOCACCI_TSP_SOLVER_H
 
 #include <memory>
+#include <vector>
 
+#include <tsppd/data/tsppd_search_statistics.h>
 #include <tsppd/solver/tsp_solver.h>
+#include <tsppd/solver/focacci/focacci_tsp_lns.h>
 #include <tsppd/solver/focacci/focacci_tsp_space.h>
 #include <tsppd/solver/focacci/brancher/focacci_tsp_brancher.h>
 #include <tsppd/solver/focacci/dual/focacci_tsp_dual.h>
@@ -32,16 +35,47 @@
 // In ICLP, vol. 97, p. 104. 1997.
 //
 // Solver Options:
-//     brancher: branching scheme {cn, regret, seq-cn} (default=regret)
+//     bfs-nodes: open node limit before diving depth-first (bfs only) (default=10000)
+//     brancher: branching scheme {action, afc, ap, cn, inc-regret, insertion, regret, seq-cn}
+//               (default=regret)
+//     decay:    decay of learned scores (action and afc only) (default=0.99)
 //     dl:       discrepancy limit (lds only)
 //     dual:     dual bounder {none, cn} (default=none)
+//     eps-depth: arcs out of +0 fixed by each subproblem (eps only) (default=2)
+//     eps-log:  report statistics as each subproblem finishes {on, off} (eps only) (default=off)
 //     filter:   reduced-cost variable domain filtering {add, ap, hk, none} (default=none)
+//     gap:      stop once (primal - dual) / primal is at most this (default=off)
 //     gist:     enables interactive search tool (implies search=bab)
+//     guided:   try each node's successor in the incumbent first {on, off} (default=off)
 //     hk-iter:  max iterations for hk 1-tree bound (default=10)
-//     search:   search engine {bab, dfs, lds} (default=bab)
+//     lns-fails: fail limit for each neighborhood (lns only) (default=200)
+//     lns-op:   neighborhood selection {random, related, worst} (lns only) (default=related)
+//     lns-size: number of nodes (tsp) or pairs (tsppd) relaxed (lns only) (default=10)
+//     portfolio: colon-separated brancher[/filter] configurations (portfolio only)
+//                (default=regret:cn:seq-cn, using the filter option)
+//     restart:  restart cutoff sequence {geometric, luby} (restart only) (default=luby)
+//     restart-scale: fails scaling the cutoff sequence (restart only) (default=100)
+//     search:   search engine {bab, bfs, dfs, eps, lds, lns, portfolio, restart} (default=bab)
 namespace TSPPD {
     namespace Solver {
-        enum FocacciTSPSearchEngine { SEARCH_BAB, SEARCH_DFS, SEARCH_LDS };
+        enum FocacciTSPSearchEngine {
+            SEARCH_BAB,
+            SEARCH_BFS,
+            SEARCH_DFS,
+            SEARCH_EPS,
+            SEARCH_LDS,
+            SEARCH_LNS,
+            SEARCH_PORTFOLIO,
+            SEARCH_RESTART
+        };
+
+        enum FocacciTSPRestartCutoff { RESTART_GEOMETRIC, RESTART_LUBY };
+
+        // One configuration run by portfolio search on its own thread.
+        struct FocacciTSPPortfolioAsset {
+            FocacciTSPBrancherType brancher_type;
+            FocacciTSPFilterType filter_type;
+        };
 
         class FocacciTSPSolver : public TSPSolver {
         public:
@@ -54,26 +88,68 @@ namespace TSPPD {
             virtual std::string name() const { return "tsp-cp"; }
             TSPPD::Data::TSPPDSolution solve();
 
+            // Searches only for tours better than solution, in place of the
+            // heuristic upper bound.
+            void warm_start(const TSPPD::Data::TSPPDSolution& solution);
+
         protected:
             void initialize_tsp_options();
+            void initialize_option_bfs();
             void initialize_option_brancher();
             void initialize_option_discrepancy_limit();
             void initialize_option_dual_bound();
+            void initialize_option_eps();
             void initialize_option_filter();
+            void initialize_option_gap();
             void initialize_option_gist();
+            void initialize_option_guided();
             void initialize_option_hk_iter();
+            void initialize_option_lns();
+            void initialize_option_portfolio();
+            void initialize_option_restart();
             void initialize_option_search();
 
+            FocacciTSPBrancherType parse_brancher_type(const std::string& brancher) const;
+            FocacciTSPFilterType parse_filter_type(const std::string& filter) const;
+
+            TSPPD::Data::TSPPDSolution solve_best_first();
+            TSPPD::Data::TSPPDSolution solve_eps();
+            TSPPD::Data::TSPPDSolution solve_portfolio();
+
+            void initialize_upper_bound();
+            int initialize_root_dual(FocacciTSPSpace& space);
+            bool gap_reached(const TSPPD::Data::TSPPDSearchStatistics& stats) const;
+
             virtual std::shared_ptr<FocacciTSPSpace> build_space();
+            std::shared_ptr<FocacciTSPSpace> initialize_space(
+                const FocacciTSPBrancherType brancher,
+                const FocacciTSPFilterType filter
+            );
 
             FocacciTSPBrancherType brancher_type;
+            double decay;
             FocacciTSPDualType dual_type;
+            unsigned int bfs_nodes;
             FocacciTSPSearchEngine search_engine;
 
             int discrepancy_limit;
+            unsigned int eps_depth;
+            bool eps_log;
             FocacciTSPFilterType filter_type;
+            double gap_limit;
             bool gist;
+            std::shared_ptr<FocacciTSPGuide> guide;
             unsigned int hk_iter;
+            FocacciTSPLNSOperator lns_operator;
+            unsigned int lns_size;
+            unsigned int lns_fails;
+            std::vector<FocacciTSPPortfolioAsset> portfolio;
+            FocacciTSPRestartCutoff restart_cutoff;
+            unsigned int restart_scale;
+
+            // Heuristic tour that search starts out having to improve on.
+            std::vector<std::string> initial_order;
+            int initial_cost;
        };
     }
 }
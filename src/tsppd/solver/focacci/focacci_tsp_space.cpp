@@ -14,18 +14,27 @@
 /*                                                                           */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <memory>
+#include <numeric>
+#include <random>
 
 #include <tsppd/solver/focacci/focacci_tsp_space.h>
+#include <tsppd/solver/focacci/brancher/focacci_tsp_activity_brancher.h>
+#include <tsppd/solver/focacci/brancher/focacci_tsp_ap_brancher.h>
 #include <tsppd/solver/focacci/brancher/focacci_tsp_closest_neighbor_brancher.h>
+#include <tsppd/solver/focacci/brancher/focacci_tsp_incremental_regret_brancher.h>
 #include <tsppd/solver/focacci/brancher/focacci_tsp_regret_brancher.h>
 #include <tsppd/solver/focacci/brancher/focacci_tsp_sequential_closest_neighbor_brancher.h>
+#include <tsppd/solver/focacci/brancher/focacci_tsppd_insertion_brancher.h>
 #include <tsppd/solver/focacci/dual/focacci_closest_neighbor_dual.h>
 #include <tsppd/solver/focacci/filter/focacci_tsp_aphk_filter.h>
 #include <tsppd/solver/focacci/filter/focacci_tsp_assignment_filter.h>
 #include <tsppd/solver/focacci/filter/focacci_tsp_heldkarp_filter.h>
 #include <tsppd/solver/focacci/filter/focacci_tsp_hkap_filter.h>
+#include <tsppd/solver/focacci/propagator/focacci_tsp_incumbent_propagator.h>
 
 using namespace Gecode;
 using namespace TSPPD::Data;
@@ -35,6 +44,14 @@ using namespace std;
 FocacciTSPSpace::FocacciTSPSpace(const TSPPDProblem& problem) :
     IntMinimizeSpace(),
     problem(problem),
+    incumbent(nullptr),
+    ap_filter(*this),
+    lns_operator(LNS_RELATED),
+    lns_size(0),
+    lns_start(nullptr),
+    tie_seed(0),
+    score_decay(1),
+    guide(nullptr),
     next(IntVarArray(*this, problem.nodes.size(), 0, problem.nodes.size() - 1)),
     length(IntVar(*this, 0, Int::Limits::max)),
     dual_bound(IntVar(*this, 0, Int::Limits::max)) { }
@@ -42,10 +59,19 @@ FocacciTSPSpace::FocacciTSPSpace(const TSPPDProblem& problem) :
 FocacciTSPSpace::FocacciTSPSpace(FocacciTSPSpace& s) :
     IntMinimizeSpace(s),
     problem(s.problem),
+    incumbent(s.incumbent),
+    ap_filter(),
+    lns_operator(s.lns_operator),
+    lns_size(s.lns_size),
+    lns_start(s.lns_start),
+    tie_seed(s.tie_seed),
+    score_decay(s.score_decay),
+    guide(s.guide),
     next(s.next),
     length(s.length),
     dual_bound(s.dual_bound) {
 
+    ap_filter.update(*this, s.ap_filter);
     next.update(*this, s.next);
     length.update(*this, s.length);
     dual_bound.update(*this, s.dual_bound);
@@ -75,7 +101,41 @@ void FocacciTSPSpace::constrain(const Space& _best) {
     if (best == nullptr)
         throw DynamicCastFailed("FocacciTSPSpace::constrain");
 
-    rel(*this, cost() <= best->cost() - 1);
+    // Other engines in a portfolio may already know of a better tour.
+    auto bound = best->cost().val();
+    if (incumbent != nullptr && incumbent->cost() < bound)
+        bound = incumbent->cost();
+
+    rel(*this, cost() <= bound - 1);
+}
+
+// Large neighborhood search: after each restart, all arcs of the last solution
+// are fixed except those into or out of a few relaxed units. Until search finds
+// a solution of its own, the initial tour is relaxed instead.
+bool FocacciTSPSpace::slave(const MetaInfo& mi) {
+    if (mi.type() != MetaInfo::RESTART || lns_size == 0)
+        return true;
+    if (mi.last() == nullptr && lns_start == nullptr)
+        return true;
+
+    vector<int> last_next(problem.nodes.size());
+    if (mi.last() == nullptr) {
+        last_next = *lns_start;
+    } else {
+        auto last = static_cast<const FocacciTSPSpace*>(mi.last());
+        for (size_t i = 0; i < problem.nodes.size(); ++i)
+            last_next[i] = last->next[i].val();
+    }
+
+    vector<bool> relaxed(problem.nodes.size(), false);
+    for (auto unit : lns_select(lns_units(), last_next, mi.restart()))
+        relaxed[unit] = true;
+
+    for (size_t i = 0; i < problem.nodes.size(); ++i)
+        if (!relaxed[i] && !relaxed[last_next[i]])
+            rel(*this, next[i], IRT_EQ, last_next[i]);
+
+    return false;
 }
 
 void FocacciTSPSpace::initialize_constraints() {
@@ -91,8 +151,26 @@ void FocacciTSPSpace::initialize_brancher(const FocacciTSPBrancherType brancher_
         FocacciTSPClosestNeighborBrancher::post(*this, next_view, problem);
     else if (brancher_type == BRANCHER_REGRET)
         FocacciTSPRegretBrancher::post(*this, next_view, problem);
+    else if (brancher_type == BRANCHER_INC_REGRET)
+        FocacciTSPIncrementalRegretBrancher::post(*this, next_view, problem);
+    else if (brancher_type == BRANCHER_AP)
+        FocacciTSPAPBrancher::post(*this, next_view, problem);
+    else if (brancher_type == BRANCHER_INSERTION)
+        FocacciTSPPDInsertionBrancher::post(*this, next_view, problem);
     else if (brancher_type == BRANCHER_SEQ_CN)
         FocacciTSPSequentialClosestNeighborBrancher::post(*this, next_view, problem);
+    else if (brancher_type == BRANCHER_ACTION)
+        FocacciTSPActivityBrancher::post(*this, next_view, problem, IntAction(*this, next_args, score_decay));
+    else if (brancher_type == BRANCHER_AFC) {
+        // Sets the decay of the failure counts the brancher reads off its views.
+        IntAFC afc(*this, next_args, score_decay);
+        FocacciTSPActivityBrancher::post(*this, next_view, problem);
+    }
+}
+
+// Must be called before initialize_brancher, which reads the decay.
+void FocacciTSPSpace::initialize_decay(const double decay) {
+    score_decay = decay;
 }
 
 void FocacciTSPSpace::initialize_dual(const FocacciTSPDualType dual_type) {
@@ -116,6 +194,116 @@ void FocacciTSPSpace::initialize_filter(const FocacciTSPFilterType filter_type,
         tsppd_hkap(*this, next, length, problem, iter);
 }
 
+// Must be called before initialize_brancher, which reads the guide.
+void FocacciTSPSpace::initialize_guide(shared_ptr<FocacciTSPGuide> solution_guide) {
+    guide = solution_guide;
+}
+
+void FocacciTSPSpace::initialize_incumbent(const TSPPDIncumbent& shared_incumbent) {
+    incumbent = &shared_incumbent;
+    tsppd_incumbent(*this, next, length, shared_incumbent);
+}
+
+// Only tours shorter than a known one are searched for.
+void FocacciTSPSpace::initialize_upper_bound(const int upper_bound) {
+    rel(*this, length < upper_bound);
+}
+
+// The start order is usually a heuristic tour already excluded by the upper bound.
+void FocacciTSPSpace::initialize_lns(
+    const FocacciTSPLNSOperator op,
+    const unsigned int size,
+    const vector<string>& start_order) {
+
+    lns_operator = op;
+    lns_size = size;
+
+    if (start_order.empty()) {
+        lns_start = nullptr;
+        return;
+    }
+
+    auto start = make_shared<vector<int>>(problem.nodes.size());
+    for (size_t i = 0; i < start_order.size(); ++i) {
+        auto j = (i + 1) % start_order.size();
+        (*start)[problem.index(start_order[i])] = problem.index(start_order[j]);
+    }
+    lns_start = start;
+}
+
+// Must be called before initialize_brancher, which reads the seed.
+void FocacciTSPSpace::initialize_random_ties(const unsigned int seed) {
+    tie_seed = seed;
+}
+
+void FocacciTSPSpace::initialize_path(const vector<unsigned int>& path) {
+    for (size_t i = 1; i < path.size(); ++i)
+        rel(*this, next[path[i - 1]], IRT_EQ, path[i]);
+}
+
+vector<FocacciTSPSubproblem> FocacciTSPSpace::decompose(const unsigned int depth) {
+    vector<FocacciTSPSubproblem> subproblems;
+    if (status() == SS_FAILED)
+        return subproblems;
+
+    vector<unsigned int> path = {0};
+    decompose(path, depth, subproblems);
+
+    stable_sort(
+        subproblems.begin(),
+        subproblems.end(),
+        [](const FocacciTSPSubproblem& a, const FocacciTSPSubproblem& b) { return a.bound < b.bound; }
+    );
+    return subproblems;
+}
+
+void FocacciTSPSpace::decompose(
+    vector<unsigned int>& path,
+    const unsigned int depth,
+    vector<FocacciTSPSubproblem>& subproblems) {
+
+    // Follow arcs that propagation has already fixed.
+    auto from = path.back();
+    auto path_size = path.size();
+    while (next[from].assigned() && path.size() < problem.nodes.size()) {
+        from = next[from].val();
+        path.push_back(from);
+    }
+
+    if (depth == 0 || next[from].assigned()) {
+        subproblems.push_back({path, length.min()});
+    } else {
+        // Children are tried in order of arc cost.
+        for (unsigned int index = 0; index < problem.arcs_size(from); ++index) {
+            auto to = problem.arc(from, index).to_index;
+            if (!next[from].in((int) to))
+                continue;
+
+            unique_ptr<FocacciTSPSpace> child(static_cast<FocacciTSPSpace*>(clone()));
+            rel(*child, child->next[from], IRT_EQ, to);
+            if (child->status() == SS_FAILED)
+                continue;
+
+            path.push_back(to);
+            child->decompose(path, depth - 1, subproblems);
+            path.pop_back();
+        }
+    }
+
+    path.resize(path_size);
+}
+
+void FocacciTSPSpace::update_guide() const {
+    if (guide == nullptr)
+        return;
+
+    vector<int> successors(next.size(), -1);
+    for (int i = 0; i < next.size(); ++i)
+        if (next[i].assigned())
+            successors[i] = next[i].val();
+    guide->update(successors);
+}
+
 vector<string> FocacciTSPSpace::solution() const {
     vector<string> s(problem.nodes.size());
 
@@ -129,6 +317,79 @@ vector<string> FocacciTSPSpace::solution() const {
     return s;
 }
 
+vector<vector<unsigned int>> FocacciTSPSpace::lns_units() const {
+    unsigned int start_index = 0;
+    unsigned int end_index = problem.index("-0");
+
+    vector<vector<unsigned int>> units;
+    for (unsigned int i = 0; i < problem.nodes.size(); ++i)
+        if (i != start_index && i != end_index)
+            units.push_back({i});
+    return units;
+}
+
+vector<unsigned int> FocacciTSPSpace::lns_select(
+    const vector<vector<unsigned int>>& units,
+    const vector<int>& last_next,
+    const unsigned long int restart) const {
+
+    // Restarts are numbered, so each neighborhood is reproducible.
+    mt19937 random(restart);
+    auto size = min((size_t) lns_size, units.size());
+
+    vector<size_t> order(units.size());
+    iota(order.begin(), order.end(), 0);
+
+    if (lns_operator == LNS_RANDOM) {
+        shuffle(order.begin(), order.end(), random);
+
+    } else if (lns_operator == LNS_RELATED) {
+        // Relax the units closest to a randomly chosen seed unit.
+        auto& seed = units[random() % units.size()];
+        vector<int> distance(units.size(), Int::Limits::max);
+        for (size_t u = 0; u < units.size(); ++u)
+            for (auto i : units[u])
+                for (auto j : seed)
+                    distance[u] = min(distance[u], i == j ? 0 : problem.cost(i, j));
+
+        stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return distance[a] < distance[b];
+        });
+
+    } else if (lns_operator == LNS_WORST) {
+        // Relax units that add the most length to the last solution, with
+        // randomization so that successive restarts try different units.
+        vector<int> last_prev(last_next.size());
+        for (size_t i = 0; i < last_next.size(); ++i)
+            last_prev[last_next[i]] = i;
+
+        vector<int> detour(units.size(), 0);
+        for (size_t u = 0; u < units.size(); ++u) {
+            for (auto i : units[u]) {
+                auto prev = last_prev[i];
+                auto succ = last_next[i];
+                detour[u] += problem.cost(prev, i) + problem.cost(i, succ) - problem.cost(prev, succ);
+            }
+        }
+
+        stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return detour[a] > detour[b];
+        });
+
+        uniform_real_distribution<double> uniform(0, 1);
+        for (size_t k = 0; k < size; ++k) {
+            auto pick = k + (size_t) (pow(uniform(random), 3) * (order.size() - k));
+            swap(order[k], order[min(pick, order.size() - 1)]);
+        }
+    }
+
+    vector<unsigned int> relaxed;
+    for (size_t k = 0; k < size; ++k)
+        for (auto i : units[order[k]])
+            relaxed.push_back(i);
+    return relaxed;
+}
+
 IntArgs FocacciTSPSpace::build_arc_costs() const {
     IntArgs arc_costs(problem.nodes.size() * problem.nodes.size());
     for (size_t from = 0; from < problem.nodes.size(); ++from) {
@@ -17,19 +17,33 @@
 #ifndef TSPPD_SOLVER_FOCACCI_TSP_SPACE_H
 #define TSPPD_SOLVER_FOCACCI_TSP_SPACE_H
 
+#include <memory>
 #include <ostream>
+#include <string>
 #include <vector>
 
 #include <gecode/int.hh>
 #include <gecode/minimodel.hh>
 
+#include <tsppd/data/tsppd_incumbent.h>
 #include <tsppd/data/tsppd_problem.h>
 #include <tsppd/solver/focacci/brancher/focacci_tsp_brancher.h>
 #include <tsppd/solver/focacci/dual/focacci_tsp_dual.h>
 #include <tsppd/solver/focacci/filter/focacci_tsp_filter.h>
+#include <tsppd/solver/focacci/focacci_tsp_actor_handle.h>
+#include <tsppd/solver/focacci/focacci_tsp_lns.h>
 
 namespace TSPPD {
     namespace Solver {
+        class FocacciTSPAssignmentFilter;
+
+        // A root subproblem for embarrassingly parallel search: the path out of
+        // +0 it fixes and its bound on length after propagation.
+        struct FocacciTSPSubproblem {
+            std::vector<unsigned int> path;
+            int bound;
+        };
+
         class FocacciTSPSpace : public Gecode::IntMinimizeSpace {
         public:
             FocacciTSPSpace(const TSPPD::Data::TSPPDProblem& problem);
@@ -40,22 +54,83 @@ namespace TSPPD {
             virtual Gecode::IntVar cost() const;
             virtual Gecode::IntVar dual() const;
             virtual void constrain(const Gecode::Space& _best);
+            virtual bool slave(const Gecode::MetaInfo& mi);
 
             virtual void print(std::ostream& out = std::cout) const;
 
             virtual void initialize_constraints();
             virtual void initialize_brancher(const FocacciTSPBrancherType brancher_type);
+            virtual void initialize_decay(const double decay);
             virtual void initialize_dual(const FocacciTSPDualType dual_type);
             virtual void initialize_filter(const FocacciTSPFilterType filter_type, const unsigned int iter);
+            virtual void initialize_guide(std::shared_ptr<FocacciTSPGuide> guide);
+            virtual void initialize_incumbent(const TSPPD::Data::TSPPDIncumbent& shared_incumbent);
+            virtual void initialize_lns(
+                const FocacciTSPLNSOperator op,
+                const unsigned int size,
+                const std::vector<std::string>& start_order
+            );
+            virtual void initialize_random_ties(const unsigned int seed);
+            virtual void initialize_upper_bound(const int upper_bound);
+            virtual void initialize_path(const std::vector<unsigned int>& path);
+
+            // Splits the space by the first depth arcs on the path out of +0.
+            // Arcs fixed by propagation do not count toward the depth, and paths
+            // that fail are dropped. Subproblems are sorted by their bounds.
+            std::vector<FocacciTSPSubproblem> decompose(const unsigned int depth);
 
             virtual std::vector<std::string> solution() const;
 
+            // AP relaxation posted by the ap or aphk filter, if any.
+            FocacciTSPActorHandle<FocacciTSPAssignmentFilter>& assignment_filter() { return ap_filter; }
+
+            // Seed for branchers to break ties with, or 0 to break them in order.
+            unsigned int random_seed() const { return tie_seed; }
+
+            // Incumbent successors for branchers to try first, if search is guided.
+            std::shared_ptr<FocacciTSPGuide> solution_guide() const { return guide; }
+            void update_guide() const;
+
         protected:
+            // Groups of nodes that are relaxed together by LNS.
+            virtual std::vector<std::vector<unsigned int>> lns_units() const;
+            std::vector<unsigned int> lns_select(
+                const std::vector<std::vector<unsigned int>>& units,
+                const std::vector<int>& last_next,
+                const unsigned long int restart
+            ) const;
+
+            void decompose(
+                std::vector<unsigned int>& path,
+                const unsigned int depth,
+                std::vector<FocacciTSPSubproblem>& subproblems
+            );
+
             Gecode::IntArgs build_arc_costs() const;
             void print_int_array(std::ostream& out, Gecode::IntVarArray array, std::string label) const;
 
             const TSPPD::Data::TSPPDProblem& problem;
 
+            // Best known tour shared with other engines (portfolio search only).
+            const TSPPD::Data::TSPPDIncumbent* incumbent;
+
+            // Set by the filter itself whenever it is posted or copied.
+            FocacciTSPActorHandle<FocacciTSPAssignmentFilter> ap_filter;
+
+            // Neighborhood settings and initial tour to relax (LNS only).
+            FocacciTSPLNSOperator lns_operator;
+            unsigned int lns_size;
+            std::shared_ptr<const std::vector<int>> lns_start;
+
+            // Random tie breaking (restart search only).
+            unsigned int tie_seed;
+
+            // Decay of learned branching scores (action and afc branchers only).
+            double score_decay;
+
+            // Successors from the best tour so far (guided search only).
+            std::shared_ptr<FocacciTSPGuide> guide;
+
             // Decision variables
             Gecode::IntVarArray next;
             Gecode::IntVar length;
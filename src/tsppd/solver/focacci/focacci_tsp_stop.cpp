@@ -0,0 +1,41 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <tsppd/solver/focacci/focacci_tsp_stop.h>
+
+using namespace Gecode;
+using namespace TSPPD::Solver;
+using namespace std;
+
+FocacciTSPStop::FocacciTSPStop(
+    const chrono::steady_clock::time_point start,
+    const unsigned int time_limit,
+    const atomic<bool>& done) :
+    start(start),
+    time_limit(time_limit),
+    done(done) { }
+
+bool FocacciTSPStop::stop(const Search::Statistics& s, const Search::Options& o) {
+    if (done)
+        return true;
+
+    if (time_limit == 0)
+        return false;
+
+    auto duration = chrono::steady_clock::now() - start;
+    auto millis = chrono::duration_cast<chrono::milliseconds>(duration);
+    return millis.count() >= time_limit;
+}
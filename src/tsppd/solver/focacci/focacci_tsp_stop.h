@@ -0,0 +1,47 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSP_STOP_H
+#define TSPPD_SOLVER_FOCACCI_TSP_STOP_H
+
+#include <atomic>
+#include <chrono>
+
+#include <gecode/search.hh>
+
+namespace TSPPD {
+    namespace Solver {
+        // Stops a search engine once the solver time limit is reached or
+        // another engine has signaled that search is complete.
+        class FocacciTSPStop : public Gecode::Search::Stop {
+        public:
+            FocacciTSPStop(
+                const std::chrono::steady_clock::time_point start,
+                const unsigned int time_limit,
+                const std::atomic<bool>& done
+            );
+
+            virtual bool stop(const Gecode::Search::Statistics& s, const Gecode::Search::Options& o);
+
+        protected:
+            const std::chrono::steady_clock::time_point start;
+            const unsigned int time_limit;
+            const std::atomic<bool>& done;
+        };
+    }
+}
+
+#endif
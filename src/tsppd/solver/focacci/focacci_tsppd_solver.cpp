@@ -37,12 +37,14 @@ void FocacciTSPPDSolver::initialize_tsppd_options() {
     // Precedence propagation
     if (options["precede"] == "" || options["precede"] == "set")
         precede_type = PRECEDE_SET;
+    else if (options["precede"] == "bitset")
+        precede_type = PRECEDE_BITSET;
     else if (options["precede"] == "cost")
         precede_type = PRECEDE_COST;
     else if (options["precede"] == "all")
         precede_type = PRECEDE_ALL;
     else
-        throw TSPPDException("precede can be either set, cost, or all");
+        throw TSPPDException("precede can be either set, bitset, cost, or all");
 
     // Order Matching Constraint propagation
     if (options["omc"] == "" || options["omc"] == "off")
@@ -51,6 +53,22 @@ void FocacciTSPPDSolver::initialize_tsppd_options() {
         omc = true;
     else
         throw TSPPDException("omc can be either on or off");
+
+    // Path fragment propagation
+    if (options["chain"] == "" || options["chain"] == "off")
+        chain = false;
+    else if (options["chain"] == "on")
+        chain = true;
+    else
+        throw TSPPDException("chain can be either on or off");
+
+    // Position viewpoint
+    if (options["pos"] == "" || options["pos"] == "off")
+        pos = false;
+    else if (options["pos"] == "on")
+        pos = true;
+    else
+        throw TSPPDException("pos can be either on or off");
 }
 
 shared_ptr<FocacciTSPSpace> FocacciTSPPDSolver::build_space() {
@@ -60,5 +78,11 @@ shared_ptr<FocacciTSPSpace> FocacciTSPPDSolver::build_space() {
     if (omc)
         space->initialize_omc_constraints();
 
+    if (chain)
+        space->initialize_chain_propagator();
+
+    if (pos)
+        space->initialize_position_viewpoint();
+
     return space;
 }
@@ -30,14 +30,24 @@
 // INFORMS Journal on Computing 14, no. 4 (2002): 403-417.
 //
 // Solver Options:
-//     brancher: branching scheme {cn, regret, seq-cn} (default=regret)
-//     precede:  precedence propagator type {set, cost, all} (default=set)
+//     brancher: branching scheme {action, afc, ap, cn, inc-regret, insertion, regret, seq-cn}
+//               (default=regret)
+//     decay:    decay of learned scores (action and afc only) (default=0.99)
+//     guided:   try each node's successor in the incumbent first {on, off} (default=off)
+//     precede:  precedence propagator type {set, bitset, cost, all} (default=set)
 //     dual:     dual bounder {none, cn} (default=none)
 //     omc:      order matching constraints (default=off)
+//     chain:    prune arcs joining path fragments out of precedence order (default=off)
+//     pos:      channel next with position variables for precedence (default=off)
 //
-//     search:   search engine {bab, dfs, lds} (default=bab)
+//     search:   search engine {bab, dfs, eps, lds, lns, portfolio, restart} (default=bab)
 //     dl:       discrepancy limit (lds only)
+//     lns-fails: fail limit for each neighborhood (lns only) (default=200)
+//     lns-op:   neighborhood selection {random, related, worst} (lns only) (default=related)
+//     lns-size: number of pickup and delivery pairs relaxed (lns only) (default=10)
+//     portfolio: colon-separated brancher[/filter] configurations (portfolio only)
 //
+//     gap:      stop once (primal - dual) / primal is at most this (default=off)
 //     gist:     enables interactive search tool
 //     threads:  number of threads to use in Gecode (default=1)
 namespace TSPPD {
@@ -58,6 +68,8 @@ namespace TSPPD {
 
             FocacciTSPPDPrecedePropagatorType precede_type;
             bool omc;
+            bool chain;
+            bool pos;
        };
     }
 }
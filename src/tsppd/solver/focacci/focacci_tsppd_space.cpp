@@ -14,7 +14,10 @@
 /*                                                                           */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#include <tsppd/solver/focacci/propagator/focacci_tsppd_chain_propagator.h>
 #include <tsppd/solver/focacci/propagator/focacci_tsppd_omc_propagator.h>
+#include <tsppd/solver/focacci/propagator/focacci_tsppd_position_propagator.h>
+#include <tsppd/solver/focacci/propagator/focacci_tsppd_precede_bitset_propagator.h>
 #include <tsppd/solver/focacci/propagator/focacci_tsppd_precede_cost_propagator.h>
 #include <tsppd/solver/focacci/propagator/focacci_tsppd_precede_set_propagator.h>
 #include <tsppd/solver/focacci/focacci_tsppd_space.h>
@@ -28,7 +31,13 @@ FocacciTSPPDSpace::FocacciTSPPDSpace(const TSPPDProblem& problem) :
     FocacciTSPSpace(problem) { }
 
 FocacciTSPPDSpace::FocacciTSPPDSpace(FocacciTSPPDSpace& s) :
-    FocacciTSPSpace(s) { }
+    FocacciTSPSpace(s),
+    pos(s.pos),
+    order(s.order) {
+
+    pos.update(*this, s.pos);
+    order.update(*this, s.order);
+}
 
 Gecode::Space* FocacciTSPPDSpace::copy() {
     return new FocacciTSPPDSpace(*this);
@@ -70,6 +79,8 @@ void FocacciTSPPDSpace::initialize_constraints() {
 void FocacciTSPPDSpace::initialize_precedence_propagators(const FocacciTSPPDPrecedePropagatorType precede_type) {
     if (precede_type == PRECEDE_SET || precede_type == PRECEDE_ALL)
         tsppd_precede_set(*this, next, problem);
+    if (precede_type == PRECEDE_BITSET)
+        tsppd_precede_bitset(*this, next, problem);
     if (precede_type == PRECEDE_COST || precede_type == PRECEDE_ALL)
         tsppd_precede_cost(*this, length, next, problem);
 }
@@ -77,3 +88,34 @@ void FocacciTSPPDSpace::initialize_precedence_propagators(const FocacciTSPPDPrec
 void FocacciTSPPDSpace::initialize_omc_constraints() {
     tsppd_omc(*this, next, problem);
 }
+
+void FocacciTSPPDSpace::initialize_chain_propagator() {
+    tsppd_chain(*this, next, problem);
+}
+
+void FocacciTSPPDSpace::initialize_position_viewpoint() {
+    unsigned int size = problem.nodes.size();
+    unsigned int start_index = 0;
+    unsigned int end_index = problem.successor_index(start_index);
+
+    pos = IntVarArray(*this, size, 0, size - 1);
+    order = IntVarArray(*this, size, 0, size - 1);
+    channel(*this, pos, order);
+
+    rel(*this, pos[start_index] == 0);
+    rel(*this, pos[end_index] == size - 1);
+
+    // Precedence as linear constraints on positions.
+    for (auto pickup : problem.pickup_indices())
+        rel(*this, pos[pickup] < pos[problem.successor_index(pickup)]);
+
+    tsppd_position(*this, next, pos, problem);
+}
+
+// Pickups and deliveries are relaxed in pairs so they can be reinserted together.
+vector<vector<unsigned int>> FocacciTSPPDSpace::lns_units() const {
+    vector<vector<unsigned int>> units;
+    for (auto pickup : problem.pickup_indices())
+        units.push_back({pickup, problem.successor_index(pickup)});
+    return units;
+}
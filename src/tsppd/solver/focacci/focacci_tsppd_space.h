@@ -39,6 +39,14 @@ namespace TSPPD {
             virtual void initialize_constraints();
             void initialize_precedence_propagators(const FocacciTSPPDPrecedePropagatorType precede_type);
             void initialize_omc_constraints();
+            void initialize_chain_propagator();
+            void initialize_position_viewpoint();
+
+        protected:
+            virtual std::vector<std::vector<unsigned int>> lns_units() const override;
+
+            Gecode::IntVarArray pos;    // position of each node in the tour (pos=on)
+            Gecode::IntVarArray order;  // node at each position in the tour (pos=on)
         };
     }
 }
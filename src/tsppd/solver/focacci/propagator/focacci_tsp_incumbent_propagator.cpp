@@ -0,0 +1,100 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <tsppd/solver/focacci/propagator/focacci_tsp_incumbent_propagator.h>
+
+using namespace Gecode;
+using namespace TSPPD::Data;
+using namespace TSPPD::Solver;
+using namespace std;
+
+FocacciTSPIncumbentPropagator::FocacciTSPIncumbentPropagator(
+    Space& home,
+    ViewArray<Int::IntView>& next,
+    Int::IntView length,
+    const TSPPDIncumbent& incumbent) :
+    Propagator(home),
+    next(next),
+    length(length),
+    incumbent(incumbent) {
+
+    next.subscribe(home, *this, Int::PC_INT_VAL);
+}
+
+FocacciTSPIncumbentPropagator::FocacciTSPIncumbentPropagator(Space& home, FocacciTSPIncumbentPropagator& p) :
+    Propagator(home, p),
+    next(p.next),
+    length(p.length),
+    incumbent(p.incumbent) {
+
+    next.update(home, p.next);
+    length.update(home, p.length);
+}
+
+Propagator* FocacciTSPIncumbentPropagator::copy(Space& home) {
+    return new (home) FocacciTSPIncumbentPropagator(home, *this);
+}
+
+size_t FocacciTSPIncumbentPropagator::dispose(Space& home) {
+    next.cancel(home, *this, Int::PC_INT_VAL);
+    (void) Propagator::dispose(home);
+    return sizeof(*this);
+}
+
+PropCost FocacciTSPIncumbentPropagator::cost(const Space& home, const ModEventDelta& med) const {
+    return PropCost::unary(PropCost::LO);
+}
+
+void FocacciTSPIncumbentPropagator::reschedule(Space& home) {
+    next.reschedule(home, *this, Int::PC_INT_VAL);
+}
+
+ExecStatus FocacciTSPIncumbentPropagator::propagate(Space& home, const ModEventDelta& med) {
+    // The shared cost only ever decreases, so reading it once per fixpoint
+    // is enough to keep every engine within the best known bound.
+    if (incumbent.has_solution())
+        GECODE_ME_CHECK(length.lq(home, incumbent.cost() - 1));
+
+    if (next.assigned())
+        return home.ES_SUBSUMED(*this);
+
+    return ES_FIX;
+}
+
+ExecStatus FocacciTSPIncumbentPropagator::post(
+    Space& home,
+    ViewArray<Int::IntView>& next,
+    Int::IntView length,
+    const TSPPDIncumbent& incumbent) {
+
+    (void) new (home) FocacciTSPIncumbentPropagator(home, next, length, incumbent);
+    return ES_OK;
+}
+
+void TSPPD::Solver::tsppd_incumbent(
+    Space& home,
+    IntVarArray& next,
+    IntVar& length,
+    const TSPPDIncumbent& incumbent) {
+
+    GECODE_POST;
+
+    IntVarArgs next_args(next);
+    ViewArray<Int::IntView> next_view(home, next_args);
+    Int::IntView length_view(length);
+
+    GECODE_ES_FAIL(FocacciTSPIncumbentPropagator::post(home, next_view, length_view, incumbent));
+}
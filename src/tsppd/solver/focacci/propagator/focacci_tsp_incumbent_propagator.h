@@ -0,0 +1,68 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSP_INCUMBENT_PROPAGATOR_H
+#define TSPPD_SOLVER_FOCACCI_TSP_INCUMBENT_PROPAGATOR_H
+
+#include <gecode/int.hh>
+
+#include <tsppd/data/tsppd_incumbent.h>
+
+namespace TSPPD {
+    namespace Solver {
+        // Bounds the tour length by a best known cost that may be improved by
+        // other search engines running concurrently.
+        class FocacciTSPIncumbentPropagator : public Gecode::Propagator {
+        public:
+            FocacciTSPIncumbentPropagator(
+                Gecode::Space& home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                Gecode::Int::IntView length,
+                const TSPPD::Data::TSPPDIncumbent& incumbent
+            );
+
+            FocacciTSPIncumbentPropagator(Gecode::Space& home, FocacciTSPIncumbentPropagator& p);
+
+            virtual Gecode::Propagator* copy(Gecode::Space& home);
+            virtual size_t dispose(Gecode::Space& home);
+
+            virtual Gecode::PropCost cost(const Gecode::Space& home, const Gecode::ModEventDelta& med) const;
+            virtual void reschedule(Gecode::Space& home);
+            virtual Gecode::ExecStatus propagate(Gecode::Space& home, const Gecode::ModEventDelta& med);
+
+            static Gecode::ExecStatus post(
+                Gecode::Space& home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                Gecode::Int::IntView length,
+                const TSPPD::Data::TSPPDIncumbent& incumbent
+            );
+
+        protected:
+            Gecode::ViewArray<Gecode::Int::IntView> next;
+            Gecode::Int::IntView length;
+            const TSPPD::Data::TSPPDIncumbent& incumbent;
+        };
+
+        void tsppd_incumbent(
+            Gecode::Space& home,
+            Gecode::IntVarArray& next,
+            Gecode::IntVar& length,
+            const TSPPD::Data::TSPPDIncumbent& incumbent
+        );
+    }
+}
+
+#endif
@@ -0,0 +1,44 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSP_INDEX_ADVISOR_H
+#define TSPPD_SOLVER_FOCACCI_TSP_INDEX_ADVISOR_H
+
+#include <gecode/int.hh>
+
+namespace TSPPD {
+    namespace Solver {
+        // Advisor on a single next variable that remembers its index, so that
+        // global propagators can tell which node's successor changed.
+        class FocacciTSPIndexAdvisor : public Gecode::ViewAdvisor<Gecode::Int::IntView> {
+        public:
+            FocacciTSPIndexAdvisor(
+                Gecode::Space& home,
+                Gecode::Propagator& p,
+                Gecode::Council<FocacciTSPIndexAdvisor>& c,
+                Gecode::Int::IntView x,
+                const unsigned int index) :
+                Gecode::ViewAdvisor<Gecode::Int::IntView>(home, p, c, x), index(index) { }
+
+            FocacciTSPIndexAdvisor(Gecode::Space& home, FocacciTSPIndexAdvisor& a) :
+                Gecode::ViewAdvisor<Gecode::Int::IntView>(home, a), index(a.index) { }
+
+            const unsigned int index;
+        };
+    }
+}
+
+#endif
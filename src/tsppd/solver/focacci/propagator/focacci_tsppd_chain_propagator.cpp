@@ -0,0 +1,223 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <tsppd/solver/focacci/propagator/focacci_tsppd_chain_propagator.h>
+
+using namespace Gecode;
+using namespace TSPPD::Data;
+using namespace TSPPD::Solver;
+using namespace std;
+
+FocacciTSPPDChainPropagator::FocacciTSPPDChainPropagator(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem) :
+    Propagator(home),
+    next(next),
+    council(home),
+    problem(problem),
+    start_index(0),
+    end_index(problem.successor_index(start_index)),
+    words((problem.pickup_indices().size() + 63) / 64),
+    pending(),
+    parent(vector<unsigned int>(next.size(), 0)),
+    head(vector<unsigned int>(next.size(), 0)),
+    tail(vector<unsigned int>(next.size(), 0)),
+    pickups(vector<uint64_t>(next.size() * words, 0)),
+    deliveries(vector<uint64_t>(next.size() * words, 0)),
+    initialized(false) {
+
+    // Every node starts out as its own fragment.
+    for (int i = 0; i < next.size(); ++i) {
+        parent[i] = i;
+        head[i] = i;
+        tail[i] = i;
+    }
+
+    auto pickup_indices = problem.pickup_indices();
+    for (unsigned int pair = 0; pair < pickup_indices.size(); ++pair) {
+        auto pickup = pickup_indices[pair];
+        auto delivery = problem.successor_index(pickup);
+        pickups[pickup * words + pair / 64] |= (uint64_t) 1 << (pair % 64);
+        deliveries[delivery * words + pair / 64] |= (uint64_t) 1 << (pair % 64);
+    }
+
+    for (int i = 0; i < next.size(); ++i) {
+        if (next[i].assigned())
+            pending.push_back(i);
+        else
+            (void) new (home) FocacciTSPIndexAdvisor(home, *this, council, next[i], i);
+    }
+
+    home.notice(*this, AP_DISPOSE);
+
+    // The first run sweeps every fragment, so arcs that already break
+    // precedence are pruned at the root.
+    Int::IntView::schedule(home, *this, Int::ME_INT_VAL);
+}
+
+FocacciTSPPDChainPropagator::FocacciTSPPDChainPropagator(Space& home, FocacciTSPPDChainPropagator& p) :
+    Propagator(home, p),
+    next(p.next),
+    problem(p.problem),
+    start_index(p.start_index),
+    end_index(p.end_index),
+    words(p.words),
+    pending(p.pending),
+    parent(p.parent),
+    head(p.head),
+    tail(p.tail),
+    pickups(p.pickups),
+    deliveries(p.deliveries),
+    initialized(p.initialized) {
+
+    next.update(home, p.next);
+    council.update(home, p.council);
+}
+
+Propagator* FocacciTSPPDChainPropagator::copy(Space& home) {
+    return new (home) FocacciTSPPDChainPropagator(home, *this);
+}
+
+size_t FocacciTSPPDChainPropagator::dispose(Space& home) {
+    home.ignore(*this, AP_DISPOSE);
+    council.dispose(home);
+    pending.~vector<unsigned int>();
+    parent.~vector<unsigned int>();
+    head.~vector<unsigned int>();
+    tail.~vector<unsigned int>();
+    pickups.~vector<uint64_t>();
+    deliveries.~vector<uint64_t>();
+    (void) Propagator::dispose(home);
+    return sizeof(*this);
+}
+
+PropCost FocacciTSPPDChainPropagator::cost(const Space& home, const ModEventDelta& med) const {
+    return PropCost::quadratic(PropCost::LO, next.size());
+}
+
+void FocacciTSPPDChainPropagator::reschedule(Space& home) {
+    if (!pending.empty() || !initialized)
+        Int::IntView::schedule(home, *this, Int::ME_INT_VAL);
+}
+
+ExecStatus FocacciTSPPDChainPropagator::advise(Space& home, Advisor& a, const Delta& d) {
+    auto& advisor = static_cast<FocacciTSPIndexAdvisor&>(a);
+    if (!advisor.view().assigned())
+        return ES_FIX;
+
+    pending.push_back(advisor.index);
+    return home.ES_NOFIX_DISPOSE(council, advisor);
+}
+
+ExecStatus FocacciTSPPDChainPropagator::propagate(Space& home, const ModEventDelta& med) {
+    // Pruning can fix more arcs, which our own advisors add to pending.
+    do {
+        // Link fragments along newly fixed arcs.
+        vector<unsigned int> merged;
+        for (auto from : pending) {
+            unsigned int to = next[from].val();
+            if (from == end_index && to == start_index)
+                continue;
+
+            auto from_root = find(from);
+            auto to_root = find(to);
+            if (from_root == to_root)
+                continue;
+
+            // Two nodes sharing a successor is left for circuit to detect,
+            // but it cannot be represented as a chain either.
+            if (tail[from_root] != from || head[to_root] != to)
+                return ES_FAILED;
+
+            if (violates(from_root, to_root))
+                return ES_FAILED;
+
+            parent[to_root] = from_root;
+            tail[from_root] = tail[to_root];
+            for (unsigned int w = 0; w < words; ++w) {
+                pickups[from_root * words + w] |= pickups[to_root * words + w];
+                deliveries[from_root * words + w] |= deliveries[to_root * words + w];
+            }
+
+            merged.push_back(from_root);
+        }
+        pending.clear();
+
+        vector<unsigned int> roots;
+        for (int i = 0; i < next.size(); ++i)
+            if (parent[i] == (unsigned int) i)
+                roots.push_back(i);
+
+        // Only fragments that changed need to be checked against the others.
+        if (!initialized) {
+            merged = roots;
+            initialized = true;
+        }
+
+        for (auto a : merged) {
+            a = find(a);
+            for (auto b : roots) {
+                if (a == b)
+                    continue;
+
+                if (violates(a, b))
+                    GECODE_ME_CHECK(next[tail[a]].nq(home, (int) head[b]));
+                if (violates(b, a))
+                    GECODE_ME_CHECK(next[tail[b]].nq(home, (int) head[a]));
+            }
+        }
+    } while (!pending.empty());
+
+    if (council.empty())
+        return home.ES_SUBSUMED(*this);
+
+    return ES_FIX;
+}
+
+ExecStatus FocacciTSPPDChainPropagator::post(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem) {
+
+    (void) new (home) FocacciTSPPDChainPropagator(home, next, problem);
+    return ES_OK;
+}
+
+unsigned int FocacciTSPPDChainPropagator::find(unsigned int node) {
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+// True if fragment from_root delivers something that fragment to_root picks up.
+bool FocacciTSPPDChainPropagator::violates(const unsigned int from_root, const unsigned int to_root) const {
+    for (unsigned int w = 0; w < words; ++w)
+        if (deliveries[from_root * words + w] & pickups[to_root * words + w])
+            return true;
+    return false;
+}
+
+void TSPPD::Solver::tsppd_chain(Home home, IntVarArray& next, const TSPPDProblem& problem) {
+    GECODE_POST;
+
+    IntVarArgs next_args(next);
+    ViewArray<Int::IntView> next_view(home, next_args);
+
+    GECODE_ES_FAIL(FocacciTSPPDChainPropagator::post(home, next_view, problem));
+}
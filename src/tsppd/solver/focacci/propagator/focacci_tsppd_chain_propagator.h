@@ -0,0 +1,87 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSPPD_CHAIN_PROPAGATOR_H
+#define TSPPD_SOLVER_FOCACCI_TSPPD_CHAIN_PROPAGATOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include <gecode/int.hh>
+
+#include <tsppd/data/tsppd_problem.h>
+#include <tsppd/solver/focacci/propagator/focacci_tsp_index_advisor.h>
+
+namespace TSPPD {
+    namespace Solver {
+        // Keeps the path fragments formed by fixed next variables in a union-find
+        // structure. Each fragment knows its head, its tail, and which pairs it
+        // holds pickups and deliveries for. Linking the tail of fragment A to the
+        // head of fragment B is removed if A holds a delivery whose pickup is in B.
+        class FocacciTSPPDChainPropagator : public Gecode::Propagator {
+        public:
+            FocacciTSPPDChainPropagator(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+            FocacciTSPPDChainPropagator(Gecode::Space& home, FocacciTSPPDChainPropagator& p);
+
+            virtual Gecode::Propagator* copy(Gecode::Space& home);
+            virtual size_t dispose(Gecode::Space& home);
+
+            virtual Gecode::PropCost cost(const Gecode::Space& home, const Gecode::ModEventDelta& med) const;
+            virtual void reschedule(Gecode::Space& home);
+            virtual Gecode::ExecStatus advise(Gecode::Space& home, Gecode::Advisor& a, const Gecode::Delta& d);
+            virtual Gecode::ExecStatus propagate(Gecode::Space& home, const Gecode::ModEventDelta& med);
+
+            static Gecode::ExecStatus post(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+        protected:
+            unsigned int find(unsigned int node);
+            bool violates(const unsigned int from_root, const unsigned int to_root) const;
+
+            Gecode::ViewArray<Gecode::Int::IntView> next;
+            Gecode::Council<FocacciTSPIndexAdvisor> council;
+            const TSPPD::Data::TSPPDProblem& problem;
+
+            const unsigned int start_index;
+            const unsigned int end_index;
+            const unsigned int words;
+
+            std::vector<unsigned int> pending;      // nodes whose next was fixed since last run
+            std::vector<unsigned int> parent;       // union-find forest over nodes
+            std::vector<unsigned int> head;         // first node of each fragment (by root)
+            std::vector<unsigned int> tail;         // last node of each fragment (by root)
+            std::vector<uint64_t> pickups;          // pairs picked up in each fragment (by root)
+            std::vector<uint64_t> deliveries;       // pairs delivered in each fragment (by root)
+            bool initialized;
+        };
+
+        void tsppd_chain(
+            Gecode::Home home,
+            Gecode::IntVarArray& next,
+            const TSPPD::Data::TSPPDProblem& problem
+        );
+    }
+}
+
+#endif
@@ -24,27 +24,39 @@ using namespace std;
 FocacciTSPPDOMCPropagator::FocacciTSPPDOMCPropagator(
     Space& home,
     ViewArray<Int::IntView>& next,
-    const unsigned int index,
     const TSPPDProblem& problem) :
     Propagator(home),
     next(next),
-    index(index),
+    council(home),
     problem(problem),
     start_index(0),
-    end_index(problem.successor_index(start_index)) {
+    end_index(problem.successor_index(start_index)),
+    pending() {
+
+    for (int i = 0; i < next.size(); ++i) {
+        if (next[i].assigned())
+            pending.push_back(i);
+        else
+            (void) new (home) FocacciTSPIndexAdvisor(home, *this, council, next[i], i);
+    }
+
+    home.notice(*this, AP_DISPOSE);
 
-    next[index].subscribe(home, *this, Int::PC_INT_VAL);
+    // Successors fixed before posting have no advisor to queue them.
+    if (!pending.empty())
+        Int::IntView::schedule(home, *this, Int::ME_INT_VAL);
 }
 
 FocacciTSPPDOMCPropagator::FocacciTSPPDOMCPropagator(Space& home, FocacciTSPPDOMCPropagator& p) :
     Propagator(home, p),
     next(p.next),
-    index(p.index),
     problem(p.problem),
     start_index(p.start_index),
-    end_index(p.end_index) {
+    end_index(p.end_index),
+    pending(p.pending) {
 
     next.update(home, p.next);
+    council.update(home, p.council);
 }
 
 Propagator* FocacciTSPPDOMCPropagator::copy(Space& home) {
@@ -52,58 +64,76 @@ Propagator* FocacciTSPPDOMCPropagator::copy(Space& home) {
 }
 
 size_t FocacciTSPPDOMCPropagator::dispose(Space& home) {
-    next[index].cancel(home, *this, Int::PC_INT_VAL);
+    home.ignore(*this, AP_DISPOSE);
+    council.dispose(home);
+    pending.~vector<unsigned int>();
     (void) Propagator::dispose(home);
     return sizeof(*this);
 }
 
 PropCost FocacciTSPPDOMCPropagator::cost(const Space& home, const ModEventDelta& med) const {
-    return PropCost::unary(PropCost::LO);
+    return PropCost::linear(PropCost::LO, (unsigned int) pending.size());
 }
 
 void FocacciTSPPDOMCPropagator::reschedule(Space& home) {
-    next[index].reschedule(home, *this, Int::PC_INT_VAL);
+    if (!pending.empty())
+        Int::IntView::schedule(home, *this, Int::ME_INT_VAL);
 }
 
-ExecStatus FocacciTSPPDOMCPropagator::propagate(Space& home, const ModEventDelta& med) {
-    unsigned int from = index;
-    unsigned int to = next[index].val();
-
-    // Ignore the (-0 +0) arc.
-    if (from == end_index && to == start_index)
-        return home.ES_SUBSUMED(*this);
-
-    if (problem.has_successor(from) && problem.has_predecessor(to)) {
-        int i_m = problem.successor_index(from);
-        int j_p = problem.predecessor_index(to);
+ExecStatus FocacciTSPPDOMCPropagator::advise(Space& home, Advisor& a, const Delta& d) {
+    auto& advisor = static_cast<FocacciTSPIndexAdvisor&>(a);
+    if (!advisor.view().assigned())
+        return ES_FIX;
 
-        // Ignore (+i -i)
-        if ((int) from == j_p)
-            return home.ES_SUBSUMED(*this);
-
-        // (+i -j) >> !(-i +j) /\ !(+j -i)
-        GECODE_ME_CHECK(next[i_m].nq(home, j_p));
-        GECODE_ME_CHECK(next[j_p].nq(home, i_m));
-
-    } else if (problem.has_predecessor(from) && problem.has_successor(to)) {
-        int i_p = problem.predecessor_index(from);
-        int j_m = problem.successor_index(to);
+    pending.push_back(advisor.index);
+    return home.ES_NOFIX_DISPOSE(council, advisor);
+}
 
-        // (-i +j) -> !(+i -j) /\ !(-j +i)
-        GECODE_ME_CHECK(next[i_p].nq(home, j_m));
-        GECODE_ME_CHECK(next[j_m].nq(home, i_p));
+ExecStatus FocacciTSPPDOMCPropagator::propagate(Space& home, const ModEventDelta& med) {
+    // Pruning can fix more arcs, which our own advisors add to pending.
+    while (!pending.empty()) {
+        unsigned int from = pending.back();
+        unsigned int to = next[from].val();
+        pending.pop_back();
+
+        // Ignore the (-0 +0) arc.
+        if (from == end_index && to == start_index)
+            continue;
+
+        if (problem.has_successor(from) && problem.has_predecessor(to)) {
+            int i_m = problem.successor_index(from);
+            int j_p = problem.predecessor_index(to);
+
+            // Ignore (+i -i)
+            if ((int) from == j_p)
+                continue;
+
+            // (+i -j) >> !(-i +j) /\ !(+j -i)
+            GECODE_ME_CHECK(next[i_m].nq(home, j_p));
+            GECODE_ME_CHECK(next[j_p].nq(home, i_m));
+
+        } else if (problem.has_predecessor(from) && problem.has_successor(to)) {
+            int i_p = problem.predecessor_index(from);
+            int j_m = problem.successor_index(to);
+
+            // (-i +j) -> !(+i -j) /\ !(-j +i)
+            GECODE_ME_CHECK(next[i_p].nq(home, j_m));
+            GECODE_ME_CHECK(next[j_m].nq(home, i_p));
+        }
     }
 
-    return home.ES_SUBSUMED(*this);
+    if (council.empty())
+        return home.ES_SUBSUMED(*this);
+
+    return ES_FIX;
 }
 
 ExecStatus FocacciTSPPDOMCPropagator::post(
     Space& home,
     ViewArray<Int::IntView>& next,
-    const unsigned int index,
     const TSPPDProblem& problem) {
 
-    (void) new (home) FocacciTSPPDOMCPropagator(home, next, index, problem);
+    (void) new (home) FocacciTSPPDOMCPropagator(home, next, problem);
     return ES_OK;
 }
 
@@ -113,7 +143,5 @@ void TSPPD::Solver::tsppd_omc(Space& home, IntVarArray& next, const TSPPDProblem
     IntVarArgs next_args(next);
     ViewArray<Int::IntView> next_view(home, next_args);
 
-    for (unsigned int index = 0; index < problem.nodes.size(); ++index)
-        if (FocacciTSPPDOMCPropagator::post(home, next_view, index, problem) != ES_OK)
-            home.fail();
+    GECODE_ES_FAIL(FocacciTSPPDOMCPropagator::post(home, next_view, problem));
 }
@@ -17,18 +17,23 @@
 #ifndef TSPPD_SOLVER_FOCACCI_TSPPD_PROPAGATOR_H
 #define TSPPD_SOLVER_FOCACCI_TSPPD_PROPAGATOR_H
 
+#include <vector>
+
 #include <gecode/int.hh>
 
 #include <tsppd/data/tsppd_problem.h>
+#include <tsppd/solver/focacci/propagator/focacci_tsp_index_advisor.h>
 
 namespace TSPPD {
     namespace Solver {
+        // A single propagator over all next variables. Advisors queue nodes as
+        // their successors are fixed, and the order matching constraints are
+        // applied to just those nodes.
         class FocacciTSPPDOMCPropagator : public Gecode::Propagator {
         public:
             FocacciTSPPDOMCPropagator(
                 Gecode::Space& home,
                 Gecode::ViewArray<Gecode::Int::IntView>& next,
-                const unsigned int index,
                 const TSPPD::Data::TSPPDProblem& problem
             );
 
@@ -39,22 +44,24 @@ namespace TSPPD {
 
             virtual Gecode::PropCost cost(const Gecode::Space& home, const Gecode::ModEventDelta& med) const;
             virtual void reschedule(Gecode::Space& home);
+            virtual Gecode::ExecStatus advise(Gecode::Space& home, Gecode::Advisor& a, const Gecode::Delta& d);
             virtual Gecode::ExecStatus propagate(Gecode::Space& home, const Gecode::ModEventDelta& med);
 
             static Gecode::ExecStatus post(
                 Gecode::Space& home,
                 Gecode::ViewArray<Gecode::Int::IntView>& next,
-                const unsigned int index,
                 const TSPPD::Data::TSPPDProblem& problem
             );
 
         protected:
             Gecode::ViewArray<Gecode::Int::IntView> next;
-            const unsigned int index;
+            Gecode::Council<FocacciTSPIndexAdvisor> council;
             const TSPPD::Data::TSPPDProblem& problem;
 
             const unsigned int start_index;
             const unsigned int end_index;
+
+            std::vector<unsigned int> pending;  // nodes with newly fixed successors
         };
 
         void tsppd_omc(
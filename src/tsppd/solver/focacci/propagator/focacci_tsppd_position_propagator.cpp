@@ -0,0 +1,248 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <algorithm>
+#include <limits>
+
+#include <tsppd/solver/focacci/propagator/focacci_tsppd_position_propagator.h>
+
+using namespace Gecode;
+using namespace TSPPD::Data;
+using namespace TSPPD::Solver;
+using namespace std;
+
+FocacciTSPPDPositionPropagator::FocacciTSPPDPositionPropagator(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    ViewArray<Int::IntView>& pos,
+    const TSPPDProblem& problem) :
+    Propagator(home),
+    next(next),
+    pos(pos),
+    council(home),
+    problem(problem),
+    start_index(0),
+    end_index(problem.successor_index(start_index)),
+    pending(),
+    queued(vector<bool>(next.size(), false)),
+    pos_min(vector<int>(next.size(), 0)),
+    pos_max(vector<int>(next.size(), 0)) {
+
+    // Advisors on next use the node index, and advisors on pos are offset by n.
+    for (int i = 0; i < next.size(); ++i) {
+        enqueue(i);
+        pos_min[i] = pos[i].min();
+        pos_max[i] = pos[i].max();
+        if (!next[i].assigned())
+            (void) new (home) FocacciTSPIndexAdvisor(home, *this, council, next[i], i);
+        if (!pos[i].assigned())
+            (void) new (home) FocacciTSPIndexAdvisor(home, *this, council, pos[i], next.size() + i);
+    }
+
+    home.notice(*this, AP_DISPOSE);
+
+    // Every node starts out queued.
+    Int::IntView::schedule(home, *this, Int::ME_INT_DOM);
+}
+
+FocacciTSPPDPositionPropagator::FocacciTSPPDPositionPropagator(Space& home, FocacciTSPPDPositionPropagator& p) :
+    Propagator(home, p),
+    next(p.next),
+    pos(p.pos),
+    problem(p.problem),
+    start_index(p.start_index),
+    end_index(p.end_index),
+    pending(p.pending),
+    queued(p.queued),
+    pos_min(p.pos_min),
+    pos_max(p.pos_max) {
+
+    next.update(home, p.next);
+    pos.update(home, p.pos);
+    council.update(home, p.council);
+}
+
+Propagator* FocacciTSPPDPositionPropagator::copy(Space& home) {
+    return new (home) FocacciTSPPDPositionPropagator(home, *this);
+}
+
+size_t FocacciTSPPDPositionPropagator::dispose(Space& home) {
+    home.ignore(*this, AP_DISPOSE);
+    council.dispose(home);
+    pending.~vector<unsigned int>();
+    queued.~vector<bool>();
+    pos_min.~vector<int>();
+    pos_max.~vector<int>();
+    (void) Propagator::dispose(home);
+    return sizeof(*this);
+}
+
+PropCost FocacciTSPPDPositionPropagator::cost(const Space& home, const ModEventDelta& med) const {
+    return PropCost::quadratic(PropCost::LO, next.size());
+}
+
+void FocacciTSPPDPositionPropagator::reschedule(Space& home) {
+    if (!pending.empty())
+        Int::IntView::schedule(home, *this, Int::ME_INT_DOM);
+}
+
+ExecStatus FocacciTSPPDPositionPropagator::advise(Space& home, Advisor& a, const Delta& d) {
+    auto& advisor = static_cast<FocacciTSPIndexAdvisor&>(a);
+    auto n = (unsigned int) next.size();
+    enqueue(advisor.index % n);
+
+    // Successors removed from a next variable lose a predecessor that may have
+    // supported their positions.
+    if (advisor.index < n) {
+        if (Int::IntView::any(d)) {
+            for (unsigned int to = 0; to < n; ++to)
+                if (!next[advisor.index].in((int) to))
+                    enqueue(to);
+        } else {
+            for (int to = Int::IntView::min(d); to <= Int::IntView::max(d); ++to)
+                enqueue(to);
+        }
+    }
+
+    if (advisor.view().assigned())
+        return home.ES_NOFIX_DISPOSE(council, advisor);
+    return ES_NOFIX;
+}
+
+ExecStatus FocacciTSPPDPositionPropagator::propagate(Space& home, const ModEventDelta& med) {
+    // Pruning changes more variables, which our own advisors add to pending.
+    while (!pending.empty()) {
+        auto node = pending.back();
+        pending.pop_back();
+        queued[node] = false;
+
+        if (node != end_index)
+            GECODE_ES_CHECK(propagate_successors(home, node));
+        if (node != start_index)
+            GECODE_ES_CHECK(propagate_predecessors(home, node));
+
+        if (pos[node].min() != pos_min[node] || pos[node].max() != pos_max[node]) {
+            pos_min[node] = pos[node].min();
+            pos_max[node] = pos[node].max();
+            enqueue_neighbors(node);
+        }
+    }
+
+    if (council.empty())
+        return home.ES_SUBSUMED(*this);
+
+    return ES_FIX;
+}
+
+ExecStatus FocacciTSPPDPositionPropagator::post(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    ViewArray<Int::IntView>& pos,
+    const TSPPDProblem& problem) {
+
+    (void) new (home) FocacciTSPPDPositionPropagator(home, next, pos, problem);
+    return ES_OK;
+}
+
+void FocacciTSPPDPositionPropagator::enqueue(const unsigned int node) {
+    if (queued[node])
+        return;
+    queued[node] = true;
+    pending.push_back(node);
+}
+
+// Possible successors and predecessors of node are bounded by its position.
+void FocacciTSPPDPositionPropagator::enqueue_neighbors(const unsigned int node) {
+    if (node != end_index)
+        for (Int::ViewValues<Int::IntView> v(next[node]); v(); ++v)
+            enqueue(v.val());
+
+    if (node != start_index)
+        for (int from = 0; from < next.size(); ++from)
+            if (from != (int) end_index && next[from].in((int) node))
+                enqueue(from);
+}
+
+// Removes successors whose positions cannot follow node, and bounds the
+// position of node by those that remain.
+ExecStatus FocacciTSPPDPositionPropagator::propagate_successors(Space& home, const unsigned int node) {
+    int low = numeric_limits<int>::max();
+    int high = numeric_limits<int>::min();
+
+    vector<int> unsupported;
+    for (Int::ViewValues<Int::IntView> v(next[node]); v(); ++v) {
+        auto to = v.val();
+        if (pos[to].max() < pos[node].min() + 1 || pos[to].min() > pos[node].max() + 1) {
+            unsupported.push_back(to);
+        } else {
+            low = min(low, pos[to].min() - 1);
+            high = max(high, pos[to].max() - 1);
+        }
+    }
+
+    if (low > high)
+        return ES_FAILED;
+
+    for (auto to : unsupported)
+        GECODE_ME_CHECK(next[node].nq(home, to));
+
+    GECODE_ME_CHECK(pos[node].gq(home, low));
+    GECODE_ME_CHECK(pos[node].lq(home, high));
+    return ES_OK;
+}
+
+// Removes node from predecessors whose positions it cannot follow, and bounds
+// the position of node by those that remain.
+ExecStatus FocacciTSPPDPositionPropagator::propagate_predecessors(Space& home, const unsigned int node) {
+    int low = numeric_limits<int>::max();
+    int high = numeric_limits<int>::min();
+
+    for (int from = 0; from < next.size(); ++from) {
+        if (from == (int) end_index || !next[from].in((int) node))
+            continue;
+
+        if (pos[from].max() < pos[node].min() - 1 || pos[from].min() > pos[node].max() - 1) {
+            GECODE_ME_CHECK(next[from].nq(home, (int) node));
+        } else {
+            low = min(low, pos[from].min() + 1);
+            high = max(high, pos[from].max() + 1);
+        }
+    }
+
+    if (low > high)
+        return ES_FAILED;
+
+    GECODE_ME_CHECK(pos[node].gq(home, low));
+    GECODE_ME_CHECK(pos[node].lq(home, high));
+    return ES_OK;
+}
+
+void TSPPD::Solver::tsppd_position(
+    Home home,
+    IntVarArray& next,
+    IntVarArray& pos,
+    const TSPPDProblem& problem) {
+
+    GECODE_POST;
+
+    IntVarArgs next_args(next);
+    ViewArray<Int::IntView> next_view(home, next_args);
+
+    IntVarArgs pos_args(pos);
+    ViewArray<Int::IntView> pos_view(home, pos_args);
+
+    GECODE_ES_FAIL(FocacciTSPPDPositionPropagator::post(home, next_view, pos_view, problem));
+}
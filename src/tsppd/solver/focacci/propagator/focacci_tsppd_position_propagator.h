@@ -0,0 +1,90 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSPPD_POSITION_PROPAGATOR_H
+#define TSPPD_SOLVER_FOCACCI_TSPPD_POSITION_PROPAGATOR_H
+
+#include <vector>
+
+#include <gecode/int.hh>
+
+#include <tsppd/data/tsppd_problem.h>
+#include <tsppd/solver/focacci/propagator/focacci_tsp_index_advisor.h>
+
+namespace TSPPD {
+    namespace Solver {
+        // Channels next variables with position variables, so that next[i] = j
+        // implies pos[j] = pos[i] + 1. Advisors queue the nodes whose next or pos
+        // variables change, along with successors removed from a next variable,
+        // and each queued node is checked against its possible successors and
+        // predecessors in O(n). A node whose position bounds move requeues its
+        // neighbors, so propagation reaches bounds consistency.
+        class FocacciTSPPDPositionPropagator : public Gecode::Propagator {
+        public:
+            FocacciTSPPDPositionPropagator(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                Gecode::ViewArray<Gecode::Int::IntView>& pos,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+            FocacciTSPPDPositionPropagator(Gecode::Space& home, FocacciTSPPDPositionPropagator& p);
+
+            virtual Gecode::Propagator* copy(Gecode::Space& home);
+            virtual size_t dispose(Gecode::Space& home);
+
+            virtual Gecode::PropCost cost(const Gecode::Space& home, const Gecode::ModEventDelta& med) const;
+            virtual void reschedule(Gecode::Space& home);
+            virtual Gecode::ExecStatus advise(Gecode::Space& home, Gecode::Advisor& a, const Gecode::Delta& d);
+            virtual Gecode::ExecStatus propagate(Gecode::Space& home, const Gecode::ModEventDelta& med);
+
+            static Gecode::ExecStatus post(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                Gecode::ViewArray<Gecode::Int::IntView>& pos,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+        protected:
+            void enqueue(const unsigned int node);
+            void enqueue_neighbors(const unsigned int node);
+            Gecode::ExecStatus propagate_successors(Gecode::Space& home, const unsigned int node);
+            Gecode::ExecStatus propagate_predecessors(Gecode::Space& home, const unsigned int node);
+
+            Gecode::ViewArray<Gecode::Int::IntView> next;
+            Gecode::ViewArray<Gecode::Int::IntView> pos;
+            Gecode::Council<FocacciTSPIndexAdvisor> council;
+            const TSPPD::Data::TSPPDProblem& problem;
+
+            const unsigned int start_index;
+            const unsigned int end_index;
+
+            std::vector<unsigned int> pending;  // nodes whose next or pos changed
+            std::vector<bool> queued;           // true if a node is in pending
+            std::vector<int> pos_min;           // bounds of pos when each node was
+            std::vector<int> pos_max;           // last checked
+        };
+
+        void tsppd_position(
+            Gecode::Home home,
+            Gecode::IntVarArray& next,
+            Gecode::IntVarArray& pos,
+            const TSPPD::Data::TSPPDProblem& problem
+        );
+    }
+}
+
+#endif
@@ -0,0 +1,313 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <tsppd/solver/focacci/propagator/focacci_tsppd_precede_bitset_propagator.h>
+
+using namespace Gecode;
+using namespace TSPPD::Data;
+using namespace TSPPD::Solver;
+using namespace std;
+
+FocacciTSPPDPrecedeBitsetPropagator::FocacciTSPPDPrecedeBitsetPropagator(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem) :
+    Propagator(home),
+    next(next),
+    council(home),
+    problem(problem),
+    start_index(0),
+    end_index(problem.successor_index(start_index)),
+    words((next.size() + 63) / 64),
+    before(vector<uint64_t>(next.size() * words, 0)),
+    after(vector<uint64_t>(next.size() * words, 0)),
+    pending(),
+    parent(vector<unsigned int>(next.size(), 0)),
+    head(vector<unsigned int>(next.size(), 0)),
+    tail(vector<unsigned int>(next.size(), 0)),
+    touched(),
+    is_touched(vector<bool>(next.size(), false)) {
+
+    // Every node starts out as its own fragment.
+    for (int i = 0; i < next.size(); ++i) {
+        parent[i] = i;
+        head[i] = i;
+        tail[i] = i;
+    }
+
+    // The start comes before everything, and everything before the end.
+    for (int i = 0; i < next.size(); ++i) {
+        if ((unsigned int) i != start_index)
+            precede(start_index, i);
+        if ((unsigned int) i != end_index)
+            precede(i, end_index);
+    }
+
+    // Pickups come before their deliveries.
+    for (auto pickup : problem.pickup_indices())
+        precede(pickup, problem.successor_index(pickup));
+
+    for (int i = 0; i < next.size(); ++i) {
+        touch(i);
+        if (next[i].assigned())
+            pending.push_back(i);
+        else
+            (void) new (home) FocacciTSPIndexAdvisor(home, *this, council, next[i], i);
+    }
+
+    home.notice(*this, AP_DISPOSE);
+
+    // Arcs that go backward are removed at the root.
+    Int::IntView::schedule(home, *this, Int::ME_INT_VAL);
+}
+
+FocacciTSPPDPrecedeBitsetPropagator::FocacciTSPPDPrecedeBitsetPropagator(
+    Space& home,
+    FocacciTSPPDPrecedeBitsetPropagator& p) :
+    Propagator(home, p),
+    next(p.next),
+    problem(p.problem),
+    start_index(p.start_index),
+    end_index(p.end_index),
+    words(p.words),
+    before(p.before),
+    after(p.after),
+    pending(p.pending),
+    parent(p.parent),
+    head(p.head),
+    tail(p.tail),
+    touched(p.touched),
+    is_touched(p.is_touched) {
+
+    next.update(home, p.next);
+    council.update(home, p.council);
+}
+
+Propagator* FocacciTSPPDPrecedeBitsetPropagator::copy(Space& home) {
+    return new (home) FocacciTSPPDPrecedeBitsetPropagator(home, *this);
+}
+
+size_t FocacciTSPPDPrecedeBitsetPropagator::dispose(Space& home) {
+    home.ignore(*this, AP_DISPOSE);
+    council.dispose(home);
+    before.~vector<uint64_t>();
+    after.~vector<uint64_t>();
+    pending.~vector<unsigned int>();
+    parent.~vector<unsigned int>();
+    head.~vector<unsigned int>();
+    tail.~vector<unsigned int>();
+    touched.~vector<unsigned int>();
+    is_touched.~vector<bool>();
+    (void) Propagator::dispose(home);
+    return sizeof(*this);
+}
+
+PropCost FocacciTSPPDPrecedeBitsetPropagator::cost(const Space& home, const ModEventDelta& med) const {
+    return PropCost::quadratic(PropCost::LO, next.size());
+}
+
+void FocacciTSPPDPrecedeBitsetPropagator::reschedule(Space& home) {
+    if (!pending.empty() || !touched.empty())
+        Int::IntView::schedule(home, *this, Int::ME_INT_VAL);
+}
+
+ExecStatus FocacciTSPPDPrecedeBitsetPropagator::advise(Space& home, Advisor& a, const Delta& d) {
+    auto& advisor = static_cast<FocacciTSPIndexAdvisor&>(a);
+    if (!advisor.view().assigned())
+        return ES_FIX;
+
+    pending.push_back(advisor.index);
+    return home.ES_NOFIX_DISPOSE(council, advisor);
+}
+
+ExecStatus FocacciTSPPDPrecedeBitsetPropagator::propagate(Space& home, const ModEventDelta& med) {
+    // Pruning can fix more arcs, which our own advisors add to pending.
+    do {
+        while (!pending.empty()) {
+            unsigned int i = pending.back();
+            unsigned int j = next[i].val();
+            pending.pop_back();
+
+            if (i == end_index && j == start_index)
+                continue;
+            if (!link(i, j))
+                return ES_FAILED;
+        }
+
+        auto nodes = touched;
+        for (auto node : touched)
+            is_touched[node] = false;
+        touched.clear();
+
+        for (auto node : nodes)
+            GECODE_ES_CHECK(prune(home, node));
+    } while (!pending.empty() || !touched.empty());
+
+    if (council.empty())
+        return home.ES_SUBSUMED(*this);
+
+    return ES_FIX;
+}
+
+ExecStatus FocacciTSPPDPrecedeBitsetPropagator::post(
+    Home home,
+    ViewArray<Int::IntView>& next,
+    const TSPPDProblem& problem) {
+
+    (void) new (home) FocacciTSPPDPrecedeBitsetPropagator(home, next, problem);
+    return ES_OK;
+}
+
+bool FocacciTSPPDPrecedeBitsetPropagator::precede(unsigned int i, unsigned int j) {
+    auto i_root = find(i);
+    auto j_root = find(j);
+    if (i_root == j_root)
+        return is_before(i, j);
+
+    // Fragments move as a whole, so their ends carry the relation.
+    i = tail[i_root];
+    j = head[j_root];
+    if (is_before(j, i))
+        return false;
+    if (is_before(i, j))
+        return true;
+
+    // Everything up to i now comes before everything from j on. Both sets
+    // are already closed, so one pass of word-wise ors keeps the closure.
+    vector<uint64_t> up_to_i(before_row(i), before_row(i) + words);
+    up_to_i[i / 64] |= (uint64_t) 1 << (i % 64);
+
+    vector<uint64_t> from_j(after_row(j), after_row(j) + words);
+    from_j[j / 64] |= (uint64_t) 1 << (j % 64);
+
+    for (unsigned int w = 0; w < words; ++w) {
+        for (auto bits = up_to_i[w]; bits != 0; bits &= bits - 1) {
+            auto node = w * 64 + __builtin_ctzll(bits);
+            auto row = after_row(node);
+            for (unsigned int x = 0; x < words; ++x)
+                row[x] |= from_j[x];
+            touch(node);
+        }
+
+        for (auto bits = from_j[w]; bits != 0; bits &= bits - 1) {
+            auto node = w * 64 + __builtin_ctzll(bits);
+            auto row = before_row(node);
+            for (unsigned int x = 0; x < words; ++x)
+                row[x] |= up_to_i[x];
+            touch(node);
+        }
+    }
+
+    return true;
+}
+
+// Whatever came before j now comes before the head of i's fragment, and
+// whatever came after i now comes after the tail of j's.
+bool FocacciTSPPDPrecedeBitsetPropagator::link(const unsigned int i, const unsigned int j) {
+    auto i_root = find(i);
+    auto j_root = find(j);
+    if (i_root == j_root || tail[i_root] != i || head[j_root] != j || !precede(i, j))
+        return false;
+
+    auto i_head = head[i_root];
+    auto j_tail = tail[j_root];
+
+    for (unsigned int w = 0; w < words; ++w) {
+        for (auto bits = before_row(j)[w] & ~before_row(i_head)[w]; bits != 0; bits &= bits - 1) {
+            auto k = w * 64 + __builtin_ctzll(bits);
+            if (find(k) != i_root && !precede(k, i_head))
+                return false;
+        }
+
+        for (auto bits = after_row(i)[w] & ~after_row(j_tail)[w]; bits != 0; bits &= bits - 1) {
+            auto k = w * 64 + __builtin_ctzll(bits);
+            if (find(k) != j_root && !precede(j_tail, k))
+                return false;
+        }
+    }
+
+    parent[j_root] = i_root;
+    tail[i_root] = j_tail;
+    return true;
+}
+
+ExecStatus FocacciTSPPDPrecedeBitsetPropagator::prune(Space& home, const unsigned int node) {
+    if (!next[node].assigned()) {
+        vector<int> removals;
+        for (Int::ViewValues<Int::IntView> v(next[node]); v(); ++v)
+            if (prunable(node, v.val()))
+                removals.push_back(v.val());
+
+        for (auto j : removals)
+            GECODE_ME_CHECK(next[node].nq(home, j));
+    }
+
+    for (int i = 0; i < next.size(); ++i)
+        if (!next[i].assigned() && next[i].in((int) node) && prunable(i, node))
+            GECODE_ME_CHECK(next[i].nq(home, (int) node));
+
+    return ES_OK;
+}
+
+bool FocacciTSPPDPrecedeBitsetPropagator::prunable(const unsigned int i, const unsigned int j) const {
+    if (i == end_index && j == start_index)
+        return false;
+    return is_before(j, i) || (is_before(i, j) && intersects(i, j));
+}
+
+unsigned int FocacciTSPPDPrecedeBitsetPropagator::find(unsigned int node) {
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+void FocacciTSPPDPrecedeBitsetPropagator::touch(const unsigned int node) {
+    if (is_touched[node])
+        return;
+    is_touched[node] = true;
+    touched.push_back(node);
+}
+
+bool FocacciTSPPDPrecedeBitsetPropagator::is_before(const unsigned int i, const unsigned int j) const {
+    return (after[i * words + j / 64] >> (j % 64)) & 1;
+}
+
+// True if some node must come after i and before j.
+bool FocacciTSPPDPrecedeBitsetPropagator::intersects(const unsigned int i, const unsigned int j) const {
+    for (unsigned int w = 0; w < words; ++w)
+        if (after[i * words + w] & before[j * words + w])
+            return true;
+    return false;
+}
+
+uint64_t* FocacciTSPPDPrecedeBitsetPropagator::before_row(const unsigned int i) {
+    return &before[i * words];
+}
+
+uint64_t* FocacciTSPPDPrecedeBitsetPropagator::after_row(const unsigned int i) {
+    return &after[i * words];
+}
+
+void TSPPD::Solver::tsppd_precede_bitset(Home home, IntVarArray& next, const TSPPDProblem& problem) {
+    GECODE_POST;
+
+    IntVarArgs next_args(next);
+    ViewArray<Int::IntView> next_view(home, next_args);
+
+    GECODE_ES_FAIL(FocacciTSPPDPrecedeBitsetPropagator::post(home, next_view, problem));
+}
@@ -0,0 +1,113 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_FOCACCI_TSPPD_PRECEDE_BITSET_PROPAGATOR_H
+#define TSPPD_SOLVER_FOCACCI_TSPPD_PRECEDE_BITSET_PROPAGATOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include <gecode/int.hh>
+
+#include <tsppd/data/tsppd_problem.h>
+#include <tsppd/solver/focacci/propagator/focacci_tsp_index_advisor.h>
+
+namespace TSPPD {
+    namespace Solver {
+        // Maintains the transitive closure of the precedence relation as packed
+        // bitsets. Row i of before holds every node known to come before i, and
+        // row i of after holds every node known to come after it.
+        //
+        // Fixed next variables join nodes into path fragments, which move as a
+        // whole: anything before one of their nodes is before their head, and
+        // anything after one is after their tail. Precedences are recorded
+        // between fragment ends, so each fixed arc is synced once, when
+        // advisors report it. Only arcs into or out of nodes with changed rows
+        // are checked for pruning.
+        class FocacciTSPPDPrecedeBitsetPropagator : public Gecode::Propagator {
+        public:
+            FocacciTSPPDPrecedeBitsetPropagator(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+            FocacciTSPPDPrecedeBitsetPropagator(Gecode::Space& home, FocacciTSPPDPrecedeBitsetPropagator& p);
+
+            virtual Gecode::Propagator* copy(Gecode::Space& home);
+            virtual size_t dispose(Gecode::Space& home);
+
+            virtual Gecode::PropCost cost(const Gecode::Space& home, const Gecode::ModEventDelta& med) const;
+            virtual void reschedule(Gecode::Space& home);
+            virtual Gecode::ExecStatus advise(Gecode::Space& home, Gecode::Advisor& a, const Gecode::Delta& d);
+            virtual Gecode::ExecStatus propagate(Gecode::Space& home, const Gecode::ModEventDelta& med);
+
+            static Gecode::ExecStatus post(
+                Gecode::Home home,
+                Gecode::ViewArray<Gecode::Int::IntView>& next,
+                const TSPPD::Data::TSPPDProblem& problem
+            );
+
+        protected:
+            // Records i before j and everything it implies. Returns false if
+            // that creates a cycle.
+            bool precede(unsigned int i, unsigned int j);
+
+            // Joins the fragments ending in i and starting with j. Returns false
+            // if that creates a cycle.
+            bool link(const unsigned int i, const unsigned int j);
+
+            // Removes the arcs out of and into node that go backward or skip
+            // over a node that must be between their ends.
+            Gecode::ExecStatus prune(Gecode::Space& home, const unsigned int node);
+            bool prunable(const unsigned int i, const unsigned int j) const;
+
+            unsigned int find(unsigned int node);
+            void touch(const unsigned int node);
+
+            bool is_before(const unsigned int i, const unsigned int j) const;
+            bool intersects(const unsigned int i, const unsigned int j) const;
+            uint64_t* before_row(const unsigned int i);
+            uint64_t* after_row(const unsigned int i);
+
+            Gecode::ViewArray<Gecode::Int::IntView> next;
+            Gecode::Council<FocacciTSPIndexAdvisor> council;
+            const TSPPD::Data::TSPPDProblem& problem;
+
+            const unsigned int start_index;
+            const unsigned int end_index;
+            const unsigned int words;
+
+            std::vector<uint64_t> before;
+            std::vector<uint64_t> after;
+
+            std::vector<unsigned int> pending;      // nodes whose next was fixed since last run
+            std::vector<unsigned int> parent;       // union-find forest over nodes
+            std::vector<unsigned int> head;         // first node of each fragment (by root)
+            std::vector<unsigned int> tail;         // last node of each fragment (by root)
+            std::vector<unsigned int> touched;      // nodes with changed rows since last run
+            std::vector<bool> is_touched;           // true if a node is in touched
+        };
+
+        void tsppd_precede_bitset(
+            Gecode::Home home,
+            Gecode::IntVarArray& next,
+            const TSPPD::Data::TSPPDProblem& problem
+        );
+    }
+}
+
+#endif
@@ -14,6 +14,11 @@
 /*                                                                           */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#include <algorithm>
+#include <limits>
+
+#include <gecode/minimodel.hh>
+
 #include <tsppd/solver/focacci/propagator/focacci_tsppd_precede_cost_propagator.h>
 
 using namespace Gecode;
@@ -25,31 +30,74 @@ FocacciTSPPDPrecedeCostPropagator::FocacciTSPPDPrecedeCostPropagator(
     Home home,
     ViewArray<Int::IntView>& next,
     ViewArray<Int::IntView>& node_cost,
-    const unsigned int index,
+    Int::IntView length,
     const TSPPDProblem& problem) :
     Propagator(home),
     next(next),
     node_cost(node_cost),
-    index(index),
+    length(length),
     problem(problem),
     start_index(0),
-    end_index(problem.successor_index(start_index)) {
+    end_index(problem.successor_index(start_index)),
+    arc_costs(problem.cost_matrix()) {
+
+    unsigned int n = next.size();
+
+    // Shortest paths between nodes. Tours never pass through the start or end
+    // in the middle, so neither is used as an intermediate node.
+    vector<int> distances(arc_costs);
+    for (unsigned int k = 0; k < n; ++k) {
+        if (k == start_index || k == end_index)
+            continue;
+        for (unsigned int i = 0; i < n; ++i)
+            for (unsigned int j = 0; j < n; ++j)
+                distances[i * n + j] = min(distances[i * n + j], distances[i * n + k] + distances[k * n + j]);
+    }
+
+    // A delivery is reached through its pickup, and a pickup must reach its
+    // delivery before the end.
+    auto head_costs = make_shared<vector<int>>(n, 0);
+    auto tail_costs = make_shared<vector<int>>(n, 0);
+    for (unsigned int i = 0; i < n; ++i) {
+        if (i == start_index || i == end_index)
+            continue;
 
-    next[index].subscribe(home, *this, Int::PC_INT_VAL);
-    node_cost[index].subscribe(home, *this, Int::PC_INT_DOM);
+        if (problem.has_predecessor(i)) {
+            auto pickup = problem.predecessor_index(i);
+            (*head_costs)[i] = distances[start_index * n + pickup] + distances[pickup * n + i];
+            (*tail_costs)[i] = distances[i * n + end_index];
+        } else {
+            auto delivery = problem.successor_index(i);
+            (*head_costs)[i] = distances[start_index * n + i];
+            (*tail_costs)[i] = distances[i * n + delivery] + distances[delivery * n + end_index];
+        }
+    }
+
+    heads = head_costs;
+    tails = tail_costs;
+
+    next.subscribe(home, *this, Int::PC_INT_DOM);
+    node_cost.subscribe(home, *this, Int::PC_INT_BND);
+    length.subscribe(home, *this, Int::PC_INT_BND);
+
+    home.notice(*this, AP_DISPOSE);
 }
 
 FocacciTSPPDPrecedeCostPropagator::FocacciTSPPDPrecedeCostPropagator(Space& home, FocacciTSPPDPrecedeCostPropagator& p) :
     Propagator(home, p),
     next(p.next),
     node_cost(p.node_cost),
-    index(p.index),
+    length(p.length),
     problem(p.problem),
     start_index(p.start_index),
-    end_index(p.end_index) {
+    end_index(p.end_index),
+    arc_costs(p.arc_costs),
+    heads(p.heads),
+    tails(p.tails) {
 
     next.update(home, p.next);
     node_cost.update(home, p.node_cost);
+    length.update(home, p.length);
 }
 
 Propagator* FocacciTSPPDPrecedeCostPropagator::copy(Space& home) {
@@ -57,60 +105,100 @@ Propagator* FocacciTSPPDPrecedeCostPropagator::copy(Space& home) {
 }
 
 size_t FocacciTSPPDPrecedeCostPropagator::dispose(Space& home) {
-    next[index].cancel(home, *this, Int::PC_INT_VAL);
-    node_cost[index].cancel(home, *this, Int::PC_INT_DOM);
+    home.ignore(*this, AP_DISPOSE);
+
+    next.cancel(home, *this, Int::PC_INT_DOM);
+    node_cost.cancel(home, *this, Int::PC_INT_BND);
+    length.cancel(home, *this, Int::PC_INT_BND);
+
+    heads.~shared_ptr<const vector<int>>();
+    tails.~shared_ptr<const vector<int>>();
 
     (void) Propagator::dispose(home);
     return sizeof(*this);
 }
 
 PropCost FocacciTSPPDPrecedeCostPropagator::cost(const Space& home, const ModEventDelta& med) const {
-    return PropCost::unary(PropCost::LO);
+    return PropCost::quadratic(PropCost::LO, next.size());
 }
 
 void FocacciTSPPDPrecedeCostPropagator::reschedule(Space& home) {
-    node_cost[index].reschedule(home, *this, Int::PC_INT_DOM);
-    next[index].reschedule(home, *this, Int::PC_INT_VAL);
+    next.reschedule(home, *this, Int::PC_INT_DOM);
+    node_cost.reschedule(home, *this, Int::PC_INT_BND);
+    length.reschedule(home, *this, Int::PC_INT_BND);
 }
 
 ExecStatus FocacciTSPPDPrecedeCostPropagator::propagate(Space& home, const ModEventDelta& med) {
-    if (!next[index].assigned())
-        return ES_FIX;
+    const long long infinity = numeric_limits<long long>::max();
+    const int n = next.size();
+
+    // Shortest path bounds from the start and to the end of the tour.
+    for (int i = 0; i < n; ++i) {
+        GECODE_ME_CHECK(node_cost[i].gq(home, (*heads)[i]));
+        GECODE_ME_CHECK(node_cost[i].lq(home, length.max() - (*tails)[i]));
+        GECODE_ME_CHECK(length.gq(home, node_cost[i].min() + (*tails)[i]));
+    }
 
-    unsigned int from = index;
-    unsigned int to = next[index].val();
+    // Pickups come before their deliveries by at least the shortest path between them.
+    for (auto pickup : problem.pickup_indices()) {
+        auto delivery = problem.successor_index(pickup);
+        // The delivery's head cost is the pickup's plus the path between them.
+        int distance = (*heads)[delivery] - (*heads)[pickup];
+        GECODE_ME_CHECK(node_cost[delivery].gq(home, node_cost[pickup].min() + distance));
+        GECODE_ME_CHECK(node_cost[pickup].lq(home, node_cost[delivery].max() - distance));
+    }
 
-    // Ignore the (-0 +0) arc.
-    if (from == end_index && to == start_index)
-        return home.ES_SUBSUMED(*this);
+    // Arrival bounds at each node from its possible successors. Bounds from
+    // each node's possible predecessors are collected at the same time.
+    vector<long long> earliest_in(n, infinity);
+    vector<long long> latest_in(n, -infinity);
+    for (int from = 0; from < n; ++from) {
+        if (from == (int) end_index)
+            continue;
+
+        long long earliest_out = infinity;
+        long long latest_out = -infinity;
+        for (Int::ViewValues<Int::IntView> v(next[from]); v(); ++v) {
+            int to = v.val();
+            if (to == (int) start_index)
+                continue;
+
+            long long c = arc_cost(from, to);
+            earliest_out = min(earliest_out, node_cost[to].min() - c);
+            latest_out = max(latest_out, node_cost[to].max() - c);
+
+            earliest_in[to] = min(earliest_in[to], node_cost[from].min() + c);
+            latest_in[to] = max(latest_in[to], node_cost[from].max() + c);
+        }
+
+        if (earliest_out == infinity)
+            continue;
+        GECODE_ME_CHECK(node_cost[from].gq(home, earliest_out));
+        GECODE_ME_CHECK(node_cost[from].lq(home, latest_out));
+    }
 
-    auto c = problem.cost(from, to);
-    if (node_cost[from].assigned())
-        GECODE_ME_CHECK(node_cost[to].eq(home, node_cost[from].val() + c));
-    else if (node_cost[to].assigned())
-        GECODE_ME_CHECK(node_cost[from].eq(home, node_cost[to].val() - c));
-    else {
-        GECODE_ME_CHECK(node_cost[to].gq(home, node_cost[from].min() + c));
-        GECODE_ME_CHECK(node_cost[to].lq(home, node_cost[from].max() + c));
-
-        GECODE_ME_CHECK(node_cost[from].gq(home, node_cost[to].min() - c));
-        GECODE_ME_CHECK(node_cost[from].lq(home, node_cost[to].max() - c));
+    // Arrival bounds at each node from its possible predecessors.
+    for (int to = 0; to < n; ++to) {
+        if (to == (int) start_index || earliest_in[to] == infinity)
+            continue;
+        GECODE_ME_CHECK(node_cost[to].gq(home, earliest_in[to]));
+        GECODE_ME_CHECK(node_cost[to].lq(home, latest_in[to]));
     }
 
-    if (node_cost[from].assigned() && node_cost[to].assigned())
+    if (next.assigned() && node_cost.assigned())
         return home.ES_SUBSUMED(*this);
 
-    return ES_FIX;
+    return ES_NOFIX;
 }
 
 ExecStatus FocacciTSPPDPrecedeCostPropagator::post(
     Home home,
     ViewArray<Int::IntView>& next,
     ViewArray<Int::IntView>& node_cost,
-    const unsigned int index,
+    Int::IntView length,
     const TSPPDProblem& problem) {
 
-    (void) new (home) FocacciTSPPDPrecedeCostPropagator(home, next, node_cost, index, problem);
+    (void) new (home) FocacciTSPPDPrecedeCostPropagator(home, next, node_cost, length, problem);
     return ES_OK;
 }
 
@@ -129,19 +217,8 @@ void TSPPD::Solver::tsppd_precede_cost(
     IntVarArgs node_cost_args(node_cost);
     ViewArray<Int::IntView> node_cost_view(home, node_cost_args);
 
-    unsigned int end_index = problem.successor_index(0);
-    for (unsigned int index = 0; index < problem.nodes.size(); ++index) {
-        rel(home, length >= node_cost[index]);
-
-        if (index == 0)
-            rel(home, node_cost[index] == 0);
-        else if (index == end_index)
-            continue;
-        else if (problem.has_predecessor(index)) {
-            auto pickup = problem.predecessor_index(index);
-            rel(home, node_cost[index] >= node_cost[pickup]);
-        }
+    rel(home, node_cost[0] == 0);
 
-        GECODE_ES_FAIL(FocacciTSPPDPrecedeCostPropagator::post(home, next_view, node_cost_view, index, problem));
-    }
-}
\ No newline at end of file
+    Int::IntView length_view(length);
+    GECODE_ES_FAIL(FocacciTSPPDPrecedeCostPropagator::post(home, next_view, node_cost_view, length_view, problem));
+}
@@ -17,20 +17,26 @@
 #ifndef TSPPD_SOLVER_FOCACCI_TSPPD_PRECEDE_COST_PROPAGATOR_H
 #define TSPPD_SOLVER_FOCACCI_TSPPD_PRECEDE_COST_PROPAGATOR_H
 
+#include <memory>
+#include <vector>
+
 #include <gecode/int.hh>
-#include <gecode/set.hh>
 
 #include <tsppd/data/tsppd_problem.h>
 
 namespace TSPPD {
     namespace Solver {
+        // Bounds the arrival cost at every node. Earliest and latest arrivals
+        // are propagated across the remaining arcs into and out of each node,
+        // and shortest paths that visit each pickup before its delivery bound
+        // the arrivals from the start and the length remaining to the end.
         class FocacciTSPPDPrecedeCostPropagator : public Gecode::Propagator {
         public:
             FocacciTSPPDPrecedeCostPropagator(
                 Gecode::Home home,
                 Gecode::ViewArray<Gecode::Int::IntView>& next,
                 Gecode::ViewArray<Gecode::Int::IntView>& node_cost,
-                const unsigned int index,
+                Gecode::Int::IntView length,
                 const TSPPD::Data::TSPPDProblem& problem
             );
 
@@ -47,18 +53,28 @@ namespace TSPPD {
                 Gecode::Home home,
                 Gecode::ViewArray<Gecode::Int::IntView>& next,
                 Gecode::ViewArray<Gecode::Int::IntView>& node_cost,
-                const unsigned int index,
+                Gecode::Int::IntView length,
                 const TSPPD::Data::TSPPDProblem& problem
             );
 
         protected:
             Gecode::ViewArray<Gecode::Int::IntView> next;
             Gecode::ViewArray<Gecode::Int::IntView> node_cost;
-            const unsigned int index;
+            Gecode::Int::IntView length;
             const TSPPD::Data::TSPPDProblem& problem;
 
             const unsigned int start_index;
             const unsigned int end_index;
+
+            const std::vector<int>& arc_costs;                  // n x n arc costs
+
+            // Computed once at post time and shared by every copy.
+            std::shared_ptr<const std::vector<int>> heads;      // shortest path cost from the start
+            std::shared_ptr<const std::vector<int>> tails;      // shortest path cost to the end
+
+            int arc_cost(const unsigned int from, const unsigned int to) const {
+                return arc_costs[from * next.size() + to];
+            }
         };
 
         void tsppd_precede_cost(
@@ -70,4 +86,4 @@ namespace TSPPD {
     }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -19,7 +19,7 @@
 
 namespace TSPPD {
     namespace Solver {
-        enum FocacciTSPPDPrecedePropagatorType { PRECEDE_ALL, PRECEDE_COST, PRECEDE_SET };
+        enum FocacciTSPPDPrecedePropagatorType { PRECEDE_ALL, PRECEDE_BITSET, PRECEDE_COST, PRECEDE_SET };
     }
 }
 
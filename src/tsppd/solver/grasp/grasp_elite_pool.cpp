@@ -0,0 +1,67 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#include <limits>
+
+#include <tsppd/solver/grasp/grasp_elite_pool.h>
+
+using namespace TSPPD::Solver;
+using namespace std;
+
+GRASPElitePool::GRASPElitePool(const unsigned int size) : slots(size, nullptr) { }
+
+bool GRASPElitePool::offer(const vector<unsigned int>& tour, const int cost) {
+    auto elite = make_shared<const GRASPElite>(GRASPElite{cost, tour});
+
+    while (true) {
+        size_t worst = 0;
+        shared_ptr<const GRASPElite> worst_elite = nullptr;
+        int worst_cost = numeric_limits<int>::min();
+
+        for (size_t i = 0; i < slots.size(); ++i) {
+            auto current = atomic_load(&slots[i]);
+            auto c = current ? current->cost : numeric_limits<int>::max();
+            if (c == cost)
+                return false;
+            if (c > worst_cost) {
+                worst = i;
+                worst_elite = current;
+                worst_cost = c;
+            }
+        }
+
+        if (cost >= worst_cost)
+            return false;
+
+        // Another thread may have replaced the elite since it was read.
+        if (atomic_compare_exchange_strong(&slots[worst], &worst_elite, elite))
+            return true;
+    }
+}
+
+shared_ptr<const vector<unsigned int>> GRASPElitePool::sample(mt19937& random) const {
+    vector<shared_ptr<const GRASPElite>> filled;
+    for (auto& slot : slots) {
+        auto elite = atomic_load(&slot);
+        if (elite)
+            filled.push_back(elite);
+    }
+
+    if (filled.empty())
+        return nullptr;
+
+    auto elite = filled[uniform_int_distribution<size_t>(0, filled.size() - 1)(random)];
+    return shared_ptr<const vector<unsigned int>>(elite, &elite->tour);
+}
@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef TSPPD_SOLVER_GRASP_ELITE_POOL_H
+#define TSPPD_SOLVER_GRASP_ELITE_POOL_H
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace TSPPD {
+    namespace Solver {
+        // An elite tour and its cost, which are published together.
+        struct GRASPElite {
+            int cost;
+            std::vector<unsigned int> tour;
+        };
+
+        // A fixed number of elite tours shared by search threads without locks.
+        // Each slot holds an immutable elite that is replaced with an atomic
+        // compare and swap, so readers always see a cost with its own tour.
+        class GRASPElitePool {
+        public:
+            GRASPElitePool(const unsigned int size);
+
+            // Replaces the worst elite if the tour is cheaper and no elite has
+            // the same cost. Returns true if the tour was added.
+            bool offer(const std::vector<unsigned int>& tour, const int cost);
+
+            // A random elite tour, or nullptr if there is none.
+            std::shared_ptr<const std::vector<unsigned int>> sample(std::mt19937& random) const;
+
+        protected:
+            std::vector<std::shared_ptr<const GRASPElite>> slots;   // nullptr if empty
+        };
+    }
+}
+
+#endif
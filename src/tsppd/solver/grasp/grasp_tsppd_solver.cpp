@@ -0,0 +1,255 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include <tsppd/data/tsppd_search_statistics.h>
+#include <tsppd/solver/grasp/grasp_tsppd_solver.h>
+#include <tsppd/util/exception.h>
+
+using namespace TSPPD::Data;
+using namespace TSPPD::Heuristic;
+using namespace TSPPD::IO;
+using namespace TSPPD::Solver;
+using namespace TSPPD::Util;
+using namespace std;
+
+GRASPTSPPDSolver::GRASPTSPPDSolver(
+    const TSPPDProblem& problem,
+    const map<string, string> options,
+    TSPSolutionWriter& writer) :
+    TSPSolver(problem, options, writer),
+    local_search(problem),
+    finished(false),
+    solutions(0) {
+
+    initialize_options();
+}
+
+TSPPDSolution GRASPTSPPDSolver::solve() {
+    if (iterations == 0 && time_limit == 0)
+        iterations = 1000;
+
+    GRASPElitePool pool(elite_size);
+    TSPPDIncumbent incumbent(problem);
+
+    vector<thread> workers;
+    for (unsigned int t = 0; t < threads; ++t)
+        workers.push_back(thread([&, t]() { search(t, pool, incumbent); }));
+    for (auto& worker : workers)
+        worker.join();
+
+    check_time_limit();
+
+    TSPPDSolution solution(problem, incumbent.has_solution() ? incumbent.order() : problem.nodes);
+    TSPPDSearchStatistics stats(solution);
+    writer.write(stats, true);
+    return solution;
+}
+
+void GRASPTSPPDSolver::initialize_options() {
+    alpha = 0.2;
+    auto alpha_pair = options.find("alpha");
+    if (alpha_pair != options.end()) {
+        try {
+            alpha = stod(alpha_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("alpha must be a number");
+        }
+        if (alpha < 0 || alpha > 1)
+            throw TSPPDException("alpha must be >= 0 and <= 1");
+    }
+
+    elite_size = 10;
+    auto elite_pair = options.find("elite");
+    if (elite_pair != options.end()) {
+        try {
+            elite_size = stoi(elite_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("elite must be an integer");
+        }
+        if (elite_size < 1)
+            throw TSPPDException("elite must be >= 1");
+    }
+
+    iterations = 0;
+    auto iter_pair = options.find("iter");
+    if (iter_pair != options.end()) {
+        try {
+            iterations = stoi(iter_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("iter must be an integer");
+        }
+        if (iterations < 1)
+            throw TSPPDException("iter must be >= 1");
+    }
+
+    relink_period = 1;
+    auto relink_pair = options.find("relink");
+    if (relink_pair != options.end()) {
+        int period;
+        try {
+            period = stoi(relink_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("relink must be an integer");
+        }
+        if (period < 0)
+            throw TSPPDException("relink must be >= 0");
+        relink_period = period;
+    }
+
+    seed = 0;
+    auto seed_pair = options.find("seed");
+    if (seed_pair != options.end()) {
+        try {
+            seed = stoi(seed_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("seed must be an integer");
+        }
+    }
+}
+
+void GRASPTSPPDSolver::search(const unsigned int thread, GRASPElitePool& pool, TSPPDIncumbent& incumbent) {
+    // The local search keeps the route it is improving, so threads need their own.
+    auto ls = local_search;
+    mt19937 random(seed + thread);
+
+    for (unsigned int iteration = 1; iterations == 0 || iteration <= iterations; ++iteration) {
+        if (finished || out_of_time())
+            break;
+
+        auto tour = construct(ls, random);
+        auto cost = ls.improve(tour);
+        offer(pool, incumbent, tour, cost);
+
+        if (relink_period == 0 || iteration % relink_period != 0)
+            continue;
+
+        auto guide = pool.sample(random);
+        if (guide == nullptr)
+            continue;
+
+        auto between = relink(ls, tour, *guide);
+        if (between.empty())
+            continue;
+
+        cost = ls.improve(between);
+        offer(pool, incumbent, between, cost);
+    }
+}
+
+vector<unsigned int> GRASPTSPPDSolver::construct(const TSPPDLocalSearch& ls, mt19937& random) const {
+    auto size = problem.nodes.size();
+    auto end_index = problem.successor_index(0);
+
+    vector<unsigned int> tour = {0};
+    vector<bool> visited(size, false);
+    visited[0] = true;
+
+    vector<unsigned int> candidates;
+    while (tour.size() + 1 < size) {
+        auto from = tour.back();
+
+        // Restricted candidate list: nodes that may come next and are within
+        // alpha of the cost range from the closest one.
+        auto min_cost = numeric_limits<int>::max();
+        auto max_cost = numeric_limits<int>::min();
+        for (unsigned int to = 0; to < size; ++to) {
+            if (visited[to] || to == end_index)
+                continue;
+            if (problem.has_predecessor(to) && !visited[problem.predecessor_index(to)])
+                continue;
+            min_cost = min(min_cost, ls.arc_cost(from, to));
+            max_cost = max(max_cost, ls.arc_cost(from, to));
+        }
+
+        auto threshold = min_cost + alpha * (max_cost - min_cost);
+
+        candidates.clear();
+        for (unsigned int to = 0; to < size; ++to) {
+            if (visited[to] || to == end_index)
+                continue;
+            if (problem.has_predecessor(to) && !visited[problem.predecessor_index(to)])
+                continue;
+            if (ls.arc_cost(from, to) <= threshold)
+                candidates.push_back(to);
+        }
+
+        auto next = candidates[uniform_int_distribution<size_t>(0, candidates.size() - 1)(random)];
+        tour.push_back(next);
+        visited[next] = true;
+    }
+
+    tour.push_back(end_index);
+    return tour;
+}
+
+vector<unsigned int> GRASPTSPPDSolver::relink(
+    const TSPPDLocalSearch& ls,
+    const vector<unsigned int>& from,
+    const vector<unsigned int>& to) const {
+
+    auto tour = from;
+    vector<unsigned int> best;
+    auto best_cost = numeric_limits<int>::max();
+
+    for (size_t k = 1; k + 1 < tour.size(); ++k) {
+        if (tour[k] == to[k])
+            continue;
+
+        auto it = find(tour.begin() + k + 1, tour.end(), to[k]);
+        rotate(tour.begin() + k, it, it + 1);
+
+        if (tour == to)
+            break;
+
+        auto cost = ls.cost(tour);
+        if (cost < best_cost) {
+            best = tour;
+            best_cost = cost;
+        }
+    }
+
+    return best;
+}
+
+void GRASPTSPPDSolver::offer(
+    GRASPElitePool& pool,
+    TSPPDIncumbent& incumbent,
+    const vector<unsigned int>& tour,
+    const int cost) {
+
+    pool.offer(tour, cost);
+    if (cost >= incumbent.cost())
+        return;
+
+    TSPPDSolution solution(problem, tour);
+    auto write = [&] { writer.write(TSPPDSearchStatistics(solution)); };
+    if (!incumbent.improve(solution.order, solution.cost, write))
+        return;
+
+    if (solution_limit > 0 && ++solutions >= solution_limit)
+        finished = true;
+}
+
+bool GRASPTSPPDSolver::out_of_time() const {
+    if (time_limit == 0)
+        return false;
+
+    auto millis = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+    return millis.count() >= time_limit;
+}
@@ -0,0 +1,107 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef TSPPD_SOLVER_GRASP_TSPPD_SOLVER_H
+#define TSPPD_SOLVER_GRASP_TSPPD_SOLVER_H
+
+#include <atomic>
+#include <random>
+#include <vector>
+
+#include <tsppd/data/tsppd_incumbent.h>
+#include <tsppd/heuristic/tsppd_local_search.h>
+#include <tsppd/solver/grasp/grasp_elite_pool.h>
+#include <tsppd/solver/tsp_solver.h>
+
+// GRASP TSPPD Solver based on:
+//
+// Thomas A. Feo and Mauricio G.C. Resende.
+// "Greedy randomized adaptive search procedures."
+// Journal of Global Optimization 6, no. 2 (1995): 109-133.
+//
+// Each thread builds tours by randomized nearest neighbor, improves them with
+// local search and offers them to an elite pool shared by all threads. Local
+// optima are periodically relinked toward a random elite, and the best tour
+// on the path between them is improved and offered as well.
+//
+// Solver Options:
+//     alpha:    share of the cost range from the closest node that may be
+//               picked next during construction (default=0.2)
+//     elite:    number of tours in the elite pool (default=10)
+//     iter:     iterations per thread (default=1000, or unlimited with a time limit)
+//     relink:   relink toward an elite every this many iterations, or 0 for
+//               never (default=1)
+//     seed:     random seed, thread t uses seed + t (default=0)
+namespace TSPPD {
+    namespace Solver {
+        class GRASPTSPPDSolver : public TSPSolver {
+        public:
+            GRASPTSPPDSolver(
+                const TSPPD::Data::TSPPDProblem& problem,
+                const std::map<std::string, std::string> options,
+                TSPPD::IO::TSPSolutionWriter& writer
+            );
+
+            virtual std::string name() const { return "tsppd-grasp"; }
+            TSPPD::Data::TSPPDSolution solve();
+
+        protected:
+            void initialize_options();
+
+            void search(
+                const unsigned int thread,
+                GRASPElitePool& pool,
+                TSPPD::Data::TSPPDIncumbent& incumbent
+            );
+
+            std::vector<unsigned int> construct(
+                const TSPPD::Heuristic::TSPPDLocalSearch& local_search,
+                std::mt19937& random
+            ) const;
+
+            // Moves nodes of from into the positions they have in to, one at a
+            // time, and returns the cheapest tour strictly between the two. Every
+            // step is precedence feasible since the prefix it extends is a prefix
+            // of a feasible tour.
+            std::vector<unsigned int> relink(
+                const TSPPD::Heuristic::TSPPDLocalSearch& local_search,
+                const std::vector<unsigned int>& from,
+                const std::vector<unsigned int>& to
+            ) const;
+
+            void offer(
+                GRASPElitePool& pool,
+                TSPPD::Data::TSPPDIncumbent& incumbent,
+                const std::vector<unsigned int>& tour,
+                const int cost
+            );
+
+            bool out_of_time() const;
+
+            TSPPD::Heuristic::TSPPDLocalSearch local_search;    // copied by each thread
+
+            double alpha;
+            unsigned int elite_size;
+            unsigned int iterations;
+            unsigned int relink_period;
+            unsigned int seed;
+
+            std::atomic<bool> finished;
+            std::atomic<unsigned int> solutions;
+       };
+    }
+}
+
+#endif
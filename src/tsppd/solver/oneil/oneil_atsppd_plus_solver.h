@@ -20,16 +20,17 @@
 #include <map>
 #include <utility>
 
-#include <tsppd/solver/focacci/focacci_tsppd_solver.h>
 #include <tsppd/solver/oneil/oneil_atsppd_solver.h>
+#include <tsppd/solver/warm_start/warm_start_tsppd_solver.h>
 
 namespace TSPPD {
     namespace Solver {
-        // MIP+CP ATSPPD Solver: O'Neil MIP ATSPPD solver with time-boxed CP warm-start.
+        // MIP+CP ATSPPD Solver: O'Neil MIP ATSPPD solver with a heuristic and/or CP warm start.
         //
         // Solver Options:
+        //     warm:       warm start source {heuristic|cp|both} (default=heuristic)
         //     warm-time:  time limit for warm start, in milliseconds
-        //     warm-soln:  solution limit for warm start
+        //     warm-soln:  solution limit for the CP warm start
         class ONeilATSPPDPlusSolver : public ONeilATSPPDSolver {
         public:
             ONeilATSPPDPlusSolver(
@@ -42,13 +43,9 @@ namespace TSPPD {
             virtual TSPPD::Data::TSPPDSolution solve() override;
 
         protected:
-            void initialize_atsppd_plus_options();
             void warm_start(const TSPPD::Data::TSPPDSolution& solution);
 
-            FocacciTSPPDSolver warm_start_solver;
-
-            unsigned int warm_time_limit;
-            unsigned int warm_solution_limit;
+            WarmStartTSPPDSolver warm_start_solver;
         };
     }
 }
@@ -54,7 +54,7 @@ namespace TSPPD {
             const TSPPD::Data::TSPPDProblem& problem;
             std::map<std::pair<unsigned int, unsigned int>, GRBVar> arcs;
             std::vector<std::shared_ptr<RulandTSPCallback>> callbacks;
-            TSPPD::IO::TSPSolutionWriter writer;
+            TSPPD::IO::TSPSolutionWriter& writer;
             TSPPD::Solver::RulandSubtourFinder subtour_finder;
 
             int primal;
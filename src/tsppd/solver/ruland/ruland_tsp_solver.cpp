@@ -60,6 +60,11 @@ TSPPDSolution RulandTSPSolver::solve() {
     // Set thread count.
     model.set(GRB_IntParam_Threads, threads);
 
+    // Start from the heuristic tour, including the edge that closes it.
+    auto tour = initial_tour();
+    for (unsigned int i = 0; i < tour.size(); ++i)
+        arcs[{tour[i], tour[(i + 1) % tour.size()]}].set(GRB_DoubleAttr_Start, 1);
+
     RulandTSPCallbackHandler callback(solver, problem, arcs, callbacks, writer);
     model.setCallback(&callback);
 
@@ -15,12 +15,10 @@
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include <tsppd/solver/ruland/ruland_tsppd_plus_solver.h>
-#include <tsppd/util/exception.h>
 
 using namespace TSPPD::Data;
 using namespace TSPPD::IO;
 using namespace TSPPD::Solver;
-using namespace TSPPD::Util;
 using namespace std;
 
 RulandTSPPDPlusSolver::RulandTSPPDPlusSolver(
@@ -30,36 +28,9 @@ RulandTSPPDPlusSolver::RulandTSPPDPlusSolver(
     RulandTSPPDSolver(problem, options, writer),
     warm_start_solver(problem, options, writer) {
 
-    initialize_tsppd_plus_options();
-
-    warm_start_solver.time_limit = warm_time_limit;
-    warm_start_solver.solution_limit = warm_solution_limit;
-
-    time_limit -= warm_time_limit;
-}
-
-void RulandTSPPDPlusSolver::initialize_tsppd_plus_options() {
-    unsigned int wl = 0;
-    auto wl_pair = options.find("warm-time");
-    if (wl_pair != options.end())
-        try {
-            wl = stoi(wl_pair->second);
-         } catch (exception &e) {
-            throw TSPPDException("warm-time must be an integer");
-         }
-
-    warm_time_limit = wl;
-
-    unsigned int sl = 0;
-    auto sl_pair = options.find("warm-soln");
-    if (sl_pair != options.end())
-        try {
-            sl = stoi(sl_pair->second);
-         } catch (exception &e) {
-            throw TSPPDException("warm-soln must be an integer");
-         }
-
-    warm_solution_limit = sl;
+    // The warm start solver starts from the heuristic tour itself, so the MIP
+    // start is only the tour it returns.
+    this->options["ub"] = "off";
 }
 
 void RulandTSPPDPlusSolver::warm_start(const TSPPDSolution& solution) {
@@ -72,5 +43,8 @@ void RulandTSPPDPlusSolver::warm_start(const TSPPDSolution& solution) {
 
 TSPPDSolution RulandTSPPDPlusSolver::solve() {
     warm_start(warm_start_solver.solve());
+
+    // Whatever the warm start leaves of the time limit goes to the MIP.
+    time_limit = warm_start_solver.remaining_time(time_limit);
     return RulandTSPPDSolver::solve();
 }
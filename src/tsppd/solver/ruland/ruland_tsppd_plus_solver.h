@@ -20,16 +20,17 @@
 #include <map>
 #include <utility>
 
-#include <tsppd/solver/focacci/focacci_tsppd_solver.h>
 #include <tsppd/solver/ruland/ruland_tsppd_solver.h>
+#include <tsppd/solver/warm_start/warm_start_tsppd_solver.h>
 
 namespace TSPPD {
     namespace Solver {
-        // MIP+CP TSPPD Solver: Ruland MIP TSPPD solver with time-boxed CP warm-start.
+        // MIP+CP TSPPD Solver: Ruland MIP TSPPD solver with a heuristic and/or CP warm start.
         //
         // Solver Options:
+        //     warm:       warm start source {heuristic|cp|both} (default=heuristic)
         //     warm-time:  time limit for warm start, in milliseconds
-        //     warm-soln:  solution limit for warm start
+        //     warm-soln:  solution limit for the CP warm start
         class RulandTSPPDPlusSolver : public RulandTSPPDSolver {
         public:
             RulandTSPPDPlusSolver(
@@ -42,13 +43,9 @@ namespace TSPPD {
             virtual TSPPD::Data::TSPPDSolution solve() override;
 
         protected:
-            void initialize_tsppd_plus_options();
             void warm_start(const TSPPD::Data::TSPPDSolution& solution);
 
-            FocacciTSPPDSolver warm_start_solver;
-
-            unsigned int warm_time_limit;
-            unsigned int warm_solution_limit;
+            WarmStartTSPPDSolver warm_start_solver;
         };
     }
 }
@@ -20,20 +20,21 @@
 #include <map>
 #include <utility>
 
-#include <tsppd/solver/focacci/focacci_tsppd_solver.h>
 #include <tsppd/solver/sarin/sarin_atsppd_solver.h>
+#include <tsppd/solver/warm_start/warm_start_tsppd_solver.h>
 
 namespace TSPPD {
     namespace Solver {
-        // MIP+CP ATSPPD Solver: Sarin MIP ATSPPD solver with time-boxed CP warm-start.
+        // MIP+CP ATSPPD Solver: Sarin MIP ATSPPD solver with a heuristic and/or CP warm start.
         //
         // Solver Options:
         //     relax:      relax model and add SEC and precedence as violated {on|off} (default=off)
         //     prec:       relaxed precedence form that uses either x or y variables {x|y} (default=x)
         //     sec:        relaxed SEC form that uses either x or y variables {subtour|cutset|y} (default=subtour)
         //     valid:      additional valid inequalities {a|b|all|none} (default=none)
+        //     warm:       warm start source {heuristic|cp|both} (default=heuristic)
         //     warm-time:  time limit for warm start, in milliseconds
-        //     warm-soln:  solution limit for warm start
+        //     warm-soln:  solution limit for the CP warm start
         class SarinATSPPDPlusSolver : public SarinATSPPDSolver {
         public:
             SarinATSPPDPlusSolver(
@@ -46,13 +47,9 @@ namespace TSPPD {
             virtual TSPPD::Data::TSPPDSolution solve() override;
 
         protected:
-            void initialize_tsppd_plus_options();
             void warm_start(const TSPPD::Data::TSPPDSolution& solution);
 
-            FocacciTSPPDSolver warm_start_solver;
-
-            unsigned int warm_time_limit;
-            unsigned int warm_solution_limit;
+            WarmStartTSPPDSolver warm_start_solver;
         };
     }
 }
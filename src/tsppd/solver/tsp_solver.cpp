@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <tsppd/heuristic/tsppd_local_search.h>
+#include <tsppd/heuristic/tsppd_pair_insertion.h>
+#include <tsppd/solver/tsp_solver.h>
+#include <tsppd/util/exception.h>
+
+using namespace TSPPD::Data;
+using namespace TSPPD::Heuristic;
+using namespace TSPPD::Solver;
+using namespace TSPPD::Util;
+using namespace std;
+
+vector<unsigned int> TSPSolver::initial_tour() {
+    auto ub_pair = options.find("ub");
+    if (ub_pair != options.end() && ub_pair->second != "on") {
+        if (ub_pair->second == "off")
+            return {};
+        throw TSPPDException("ub can be either on or off");
+    }
+
+    // Plain TSP instances have no -0 node for insertion to build a tour to.
+    if (!problem.has_successor(0))
+        return {};
+
+    auto tour = TSPPDPairInsertion(problem).construct(2);
+    TSPPDLocalSearch local_search(problem);
+    local_search.improve(tour);
+
+    // A tour that misses nodes or breaks precedence would cut off every
+    // feasible one when used as a bound.
+    if (!local_search.feasible(tour))
+        return {};
+
+    writer.write(TSPPDSolution(problem, tour));
+    return tour;
+}
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <tsppd/data/tsppd_problem.h>
 #include <tsppd/data/tsppd_solution.h>
@@ -48,6 +49,13 @@ namespace TSPPD {
             unsigned int threads = 1;
 
         protected:
+            // Tour built by regret-2 insertion and improved by local search, for
+            // exact solvers to start from as their first incumbent. It is
+            // written out as a solution. Empty if the option ub=off is given, if
+            // the problem has no pickup and delivery pairs, or if the tour built
+            // is not feasible.
+            std::vector<unsigned int> initial_tour();
+
             void check_time_limit() {
                 if (time_limit == 0)
                     return;
@@ -0,0 +1,122 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <chrono>
+
+#include <tsppd/heuristic/tsppd_local_search.h>
+#include <tsppd/heuristic/tsppd_pair_insertion.h>
+#include <tsppd/solver/alns/alns_tsppd_solver.h>
+#include <tsppd/solver/focacci/focacci_tsppd_solver.h>
+#include <tsppd/solver/warm_start/warm_start_tsppd_solver.h>
+#include <tsppd/util/exception.h>
+
+using namespace TSPPD::Data;
+using namespace TSPPD::Heuristic;
+using namespace TSPPD::IO;
+using namespace TSPPD::Solver;
+using namespace TSPPD::Util;
+using namespace std;
+
+WarmStartTSPPDSolver::WarmStartTSPPDSolver(
+    const TSPPDProblem& problem,
+    const map<string, string> options,
+    TSPSolutionWriter& writer) :
+    TSPSolver(problem, options, writer) {
+
+    initialize_options();
+}
+
+TSPPDSolution WarmStartTSPPDSolver::solve() {
+    if (source == WARM_START_HEURISTIC)
+        return solve_heuristic(time_limit);
+    if (source == WARM_START_CP)
+        return solve_cp(time_limit, nullptr);
+
+    // Without a time limit, CP runs until it proves the ALNS tour optimal or
+    // improves on it.
+    auto heuristic_time_limit = time_limit / 2;
+    auto solution = solve_heuristic(heuristic_time_limit);
+    return solve_cp(time_limit - heuristic_time_limit, &solution);
+}
+
+unsigned int WarmStartTSPPDSolver::remaining_time(const unsigned int limit) const {
+    if (limit == 0)
+        return 0;
+
+    auto duration = chrono::steady_clock::now() - start;
+    auto millis = chrono::duration_cast<chrono::milliseconds>(duration).count();
+    return millis < limit ? limit - millis : 1;
+}
+
+void WarmStartTSPPDSolver::initialize_options() {
+    auto warm_pair = options.find("warm");
+    if (warm_pair == options.end() || warm_pair->second == "heuristic")
+        source = WARM_START_HEURISTIC;
+    else if (warm_pair->second == "cp")
+        source = WARM_START_CP;
+    else if (warm_pair->second == "both")
+        source = WARM_START_BOTH;
+    else
+        throw TSPPDException("warm can be either heuristic, cp, or both");
+
+    auto wl_pair = options.find("warm-time");
+    if (wl_pair != options.end())
+        try {
+            time_limit = stoi(wl_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("warm-time must be an integer");
+        }
+
+    auto sl_pair = options.find("warm-soln");
+    if (sl_pair != options.end())
+        try {
+            solution_limit = stoi(sl_pair->second);
+        } catch (exception &e) {
+            throw TSPPDException("warm-soln must be an integer");
+        }
+}
+
+TSPPDSolution WarmStartTSPPDSolver::solve_heuristic(const unsigned int heuristic_time_limit) {
+    if (heuristic_time_limit > 0) {
+        ALNSTSPPDSolver alns_solver(problem, options, writer);
+        alns_solver.time_limit = heuristic_time_limit;
+        return alns_solver.solve();
+    }
+
+    auto tour = TSPPDPairInsertion(problem).construct(2);
+    TSPPDLocalSearch(problem).improve(tour);
+
+    TSPPDSolution solution(problem, tour);
+    writer.write(solution);
+    return solution;
+}
+
+TSPPDSolution WarmStartTSPPDSolver::solve_cp(
+    const unsigned int cp_time_limit,
+    const TSPPDSolution* incumbent) {
+
+    // The ALNS tour is the upper bound, so CP does not build its own.
+    auto cp_options = options;
+    if (incumbent)
+        cp_options["ub"] = "off";
+
+    FocacciTSPPDSolver cp_solver(problem, cp_options, writer);
+    cp_solver.time_limit = cp_time_limit;
+    cp_solver.solution_limit = solution_limit;
+    if (incumbent)
+        cp_solver.warm_start(*incumbent);
+    return cp_solver.solve();
+}
@@ -0,0 +1,70 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*  This file is part of the tsppd program and library for solving           */
+/*  Traveling Salesman Problems with Pickup and Delivery. tsppd requires     */
+/*  other commercial and open source software to build. tsppd is decribed    */
+/*  in the paper "Exact Methods for Solving Traveling Salesman Problems      */
+/*  with Pickup and Delivery in Real Time".                                  */
+/*                                                                           */
+/*  Copyright (C) 2017 Ryan J. O'Neil <roneil1@gmu.edu>                      */
+/*                                                                           */
+/*  tsppd is distributed under the terms of the ZIB Academic License.        */
+/*  You should have received a copy of the ZIB Academic License along with   */
+/*  tsppd. See the file LICENSE. If not, email roneil1@gmu.edu.              */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef TSPPD_SOLVER_WARM_START_TSPPD_SOLVER_H
+#define TSPPD_SOLVER_WARM_START_TSPPD_SOLVER_H
+
+#include <map>
+#include <string>
+
+#include <tsppd/solver/tsp_solver.h>
+
+// Warm Start TSPPD Solver: finds the tour MIP+CP solvers use as a MIP start.
+//
+// The heuristic source builds a tour with regret-2 insertion and local
+// search in milliseconds, then hands any warm-time it has to tsppd-alns. The
+// CP source runs tsppd-focacci. Using both splits warm-time evenly between ALNS
+// and CP, with CP searching only for tours better than the one ALNS found.
+//
+// Solver Options:
+//     warm:       warm start source {heuristic|cp|both} (default=heuristic)
+//     warm-time:  time limit for warm start, in milliseconds
+//     warm-soln:  solution limit for the CP warm start
+namespace TSPPD {
+    namespace Solver {
+        enum WarmStartSource { WARM_START_HEURISTIC, WARM_START_CP, WARM_START_BOTH };
+
+        class WarmStartTSPPDSolver : public TSPSolver {
+        public:
+            WarmStartTSPPDSolver(
+                const TSPPD::Data::TSPPDProblem& problem,
+                const std::map<std::string, std::string> options,
+                TSPPD::IO::TSPSolutionWriter& writer
+            );
+
+            virtual std::string name() const { return "tsppd-warm"; }
+            TSPPD::Data::TSPPDSolution solve();
+
+            // Part of a time limit left once warm starting is done. Never 0
+            // unless the limit is, since 0 means no limit.
+            unsigned int remaining_time(const unsigned int limit) const;
+
+        protected:
+            void initialize_options();
+
+            TSPPD::Data::TSPPDSolution solve_heuristic(const unsigned int heuristic_time_limit);
+            // CP only searches for tours better than incumbent, if given.
+            TSPPD::Data::TSPPDSolution solve_cp(
+                const unsigned int cp_time_limit,
+                const TSPPD::Data::TSPPDSolution* incumbent
+            );
+
+            WarmStartSource source;
+        };
+    }
+}
+
+#endif
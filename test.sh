@@ -27,6 +27,10 @@ run() {
     $1 -f csv | csvcut -c primal | tail -1 >> .out
 }
 
+nodes() {
+    $1 -f csv | csvcut -c nodes | tail -1
+}
+
 FAILED=0
 for PROB in $PROB; do
     for SIZE in $ITER_SIZE; do
@@ -41,21 +45,51 @@ for PROB in $PROB; do
             # Enum
             if [ $SIZE -le 5 ]; then
                 run "$CMD -s $PROB-enum"
+                run "$CMD -s $PROB-enum -o bitmask=off"
+            fi
+
+            # DP
+            if [ "$PROB" == "tsppd" ]; then
+                run "$CMD -s $PROB-dp"
+                run "$CMD -s $PROB-dp -p 2 -o split=1"
             fi
 
             # CP
-            run "$CMD -s $PROB-cp"
-            run "$CMD -s $PROB-cp -o threads=2"
+            run "$CMD -s $PROB-focacci"
+            run "$CMD -s $PROB-focacci -o threads=2"
+
+            for SEARCH in bfs portfolio restart; do
+                run "$CMD -s $PROB-focacci -o search=$SEARCH"
+            done
+            run "$CMD -s $PROB-focacci -o search=eps -p 2"
+            run "$CMD -s $PROB-focacci -o search=lns -t 1000"
 
-            for BRANCH in cn seq-cn regret; do
-                run "$CMD -s $PROB-cp -o brancher=$BRANCH"
+            for BRANCH in action afc cn inc-regret regret seq-cn; do
+                run "$CMD -s $PROB-focacci -o brancher=$BRANCH"
             done
 
+            # inc-regret must make the same choices as regret.
+            SAME_NODES=1
+            if [ "$(nodes "$CMD -s $PROB-focacci -o brancher=regret")" != \
+                 "$(nodes "$CMD -s $PROB-focacci -o brancher=inc-regret")" ]; then
+                SAME_NODES=0
+            fi
+
+            run "$CMD -s $PROB-focacci -o brancher=ap -o filter=ap"
+
+            run "$CMD -s $PROB-focacci -o guided=on"
+            run "$CMD -s $PROB-focacci -o dual=cn"
+
             if [ "$PROB" == "tsppd" ]; then
-                run "$CMD -s $PROB-cp -o ap=on"
+                run "$CMD -s $PROB-focacci -o ap=on"
+                run "$CMD -s $PROB-focacci -o brancher=insertion"
+
+                for OPTION in chain omc pos; do
+                    run "$CMD -s $PROB-focacci -o $OPTION=on"
+                done
 
-                for PRECEDE in all cost set; do
-                    run "$CMD -s $PROB-cp -o precede=$PRECEDE"
+                for PRECEDE in all bitset cost set; do
+                    run "$CMD -s $PROB-focacci -o precede=$PRECEDE"
                 done
             fi
 
@@ -68,7 +102,7 @@ for PROB in $PROB; do
                 run "$CMD -s $PROB-mip+ -o warm-time=50"
             fi
 
-            if [ $(sort .out | uniq | wc -l) -eq 1 ]; then
+            if [ $(sort .out | uniq | wc -l) -eq 1 ] && [ $SAME_NODES -eq 1 ]; then
                 echo "ok"
             else
                 echo "failed"